@@ -16,18 +16,28 @@ from loggers import _sp_logger
 # Source.Python Imports
 #   Commands
 from _commands import Command
+from _commands import CommandProfiler
+from _commands import CommandRateLimiter
 from _commands import CommandReturn
+from _commands import CommandType
 from _commands import ConCommand
 from _commands import ConCommandBase
+from _commands import command_profiler
+from _commands import command_rate_limiter
 
 
 # =============================================================================
 # >> ALL DECLARATION
 # =============================================================================
 __all__ = ('Command',
+           'CommandProfiler',
+           'CommandRateLimiter',
            'CommandReturn',
+           'CommandType',
            'ConCommand',
            'ConCommandBase',
+           'command_profiler',
+           'command_rate_limiter',
            )
 
 
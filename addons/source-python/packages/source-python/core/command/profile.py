@@ -0,0 +1,118 @@
+# ../core/command/profile.py
+
+"""Registers the sp profile sub-commands."""
+
+# =============================================================================
+# >> IMPORTS
+# =============================================================================
+# Python Imports
+#   Timeit
+from timeit import timeit
+
+# Source.Python Imports
+#   Commands
+from commands import command_profiler
+from commands.typed import TypedServerCommand
+#   Core
+from core.command import core_command
+from core.command import core_command_logger
+#   Entities
+from entities.entity import Entity
+#   Mathlib
+from mathlib import Vector
+from mathlib import get_free_list_stats
+from mathlib import is_free_list_enabled
+from mathlib import set_free_list_enabled
+
+
+# =============================================================================
+# >> GLOBALS
+# =============================================================================
+logger = core_command_logger.profile
+
+
+# =============================================================================
+# >> sp profile commands
+# =============================================================================
+@core_command.server_sub_command(['profile', 'commands', 'start'])
+def _sp_profile_commands_start(command_info):
+    """Start profiling server, client and say commands."""
+    command_profiler.enabled = True
+    logger.log_message('Command profiling has been started.')
+
+
+@core_command.server_sub_command(['profile', 'commands', 'stop'])
+def _sp_profile_commands_stop(command_info):
+    """Stop profiling commands."""
+    command_profiler.enabled = False
+    logger.log_message('Command profiling has been stopped.')
+
+
+@core_command.server_sub_command(['profile', 'commands', 'reset'])
+def _sp_profile_commands_reset(command_info):
+    """Remove all recorded command statistics."""
+    command_profiler.reset()
+    logger.log_message('Command statistics have been reset.')
+
+
+@core_command.server_sub_command(['profile', 'commands', 'dump'])
+def _sp_profile_commands_dump(command_info, count:int=20):
+    """Print the commands that spent the most time in Python."""
+    result = '\n{:<7} {:<32} {:>8} {:>8} {:>12} {:>10}\n'.format(
+        'Type', 'Command', 'Calls', 'Blocked', 'Total (ms)', 'Max (ms)')
+    result += '-' * 82 + '\n'
+    for (command_type, name, calls, blocked, total,
+            maximum) in command_profiler.get_hot_commands(count):
+        result += '{:<7} {:<32} {:>8} {:>8} {:>12.3f} {:>10.3f}\n'.format(
+            command_type.name.lower(), name, calls, blocked,
+            total * 1000, maximum * 1000)
+
+    if not command_profiler.enabled:
+        result += '\nCommand profiling is not enabled. Use ' \
+            '"sp profile commands start" to enable it.\n'
+
+    logger.log_message(result)
+
+
+@core_command.server_sub_command(['profile', 'free_list'])
+def _sp_profile_free_list(command_info, iterations:int=100000):
+    """Compare the cost of Vector allocations with and without free list."""
+    # Every entity has an origin, so the world entity is always good enough
+    entity = Entity(0)
+    output = Vector()
+    benchmarks = (
+        ('entity.origin', lambda: entity.origin),
+        ('entity.get_origin_into()', lambda: entity.get_origin_into(output)),
+    )
+
+    was_enabled = is_free_list_enabled()
+    result = '\n{:<26} {:>14} {:>14}\n'.format(
+        'Accessor', 'Enabled (ms)', 'Disabled (ms)')
+    result += '-' * 56 + '\n'
+    try:
+        for name, callback in benchmarks:
+            timings = []
+            for enabled in (True, False):
+                set_free_list_enabled(enabled)
+                timings.append(timeit(callback, number=iterations) * 1000)
+
+            result += '{:<26} {:>14.3f} {:>14.3f}\n'.format(name, *timings)
+    finally:
+        set_free_list_enabled(was_enabled)
+
+    allocated, reused, size = get_free_list_stats()['Vector']
+    result += '\n{} iterations. Vector: {} allocated, {} reused, {} ' \
+        'in the free list.\n'.format(iterations, allocated, reused, size)
+
+    logger.log_message(result)
+
+
+# =============================================================================
+# >> DESCRIPTIONS
+# =============================================================================
+TypedServerCommand.parser.set_node_description(
+    ['sp', 'profile'], 'Profile Source.Python.')
+
+TypedServerCommand.parser.set_node_description(
+    ['sp', 'profile', 'commands'],
+    'Profile the Python callbacks of server, client and say commands.')
@@ -43,6 +43,9 @@ from configobj import Section
 # Source.Python Imports
 #   Effects
 from _effects._base import BaseTempEntity
+from _effects._base import TempEntityFieldType
+from _effects._base import TempEntityLayout
+from _effects._base import create_and_send
 
 
 # =============================================================================
@@ -50,6 +53,9 @@ from _effects._base import BaseTempEntity
 # =============================================================================
 __all__ = ('BaseTempEntity',
            'TempEntity',
+           'TempEntityFieldType',
+           'TempEntityLayout',
+           'create_and_send',
            )
 
 
@@ -200,6 +206,18 @@ class TempEntity(BaseTempEntity):
         :param object value:
             The value to set.
         """
+        # Get the native layout of the template...
+        layout = self.template.layout
+
+        # Can the alias be written natively?
+        if name in layout:
+
+            # Set the value of the alias...
+            layout.set_field(self, name, value)
+
+            # No need to go further...
+            return
+
         # Get the name of the prop...
         prop_name = self.template.aliases.get(name, None)
 
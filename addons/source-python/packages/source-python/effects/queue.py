@@ -0,0 +1,37 @@
+# ../effects/queue.py
+
+"""Provides a native queue that batches temp entities until the end of the
+frame.
+
+Queued temp entities are coalesced by their recipients and sent in one pass.
+If a player would receive more temp entities in a frame than allowed, the ones
+with the lowest priority are dropped for that player.
+
+Example:
+
+.. code:: python
+
+    from effects.queue import temp_entity_queue
+
+    for start, end in segments:
+        temp_entity_queue.enqueue(
+            'BeamPoints', recipients, priority=1,
+            start_point=start, end_point=end, model=model, halo=model,
+            life_time=0.1, start_width=2, end_width=2, color=color)
+"""
+
+# =============================================================================
+# >> FORWARD IMPORTS
+# =============================================================================
+# Source.Python Imports
+#   Effects
+from _effects._queue import TempEntityQueue
+from _effects._queue import temp_entity_queue
+
+
+# =============================================================================
+# >> ALL DECLARATION
+# =============================================================================
+__all__ = ('TempEntityQueue',
+           'temp_entity_queue',
+           )
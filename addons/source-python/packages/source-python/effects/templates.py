@@ -10,9 +10,15 @@
 from core import GameConfigObj
 #   Effects
 from _effects._base import BaseTempEntity
+from _effects._base import TempEntityFieldType
+from _effects._base import TempEntityLayout
+#   Engines
+from engines.precache import Decal
+from engines.precache import Model
 #   Entities
 from entities.classes import _supported_property_types
 from entities.classes import server_classes
+from entities.entity import Entity
 from entities.props import SendPropType
 #   Memory
 from memory import TYPE_SIZES
@@ -37,6 +43,27 @@ __all__ = ('TempEntityTemplate',
            )
 
 
+# =============================================================================
+# >> GLOBAL VARIABLES
+# =============================================================================
+# Property types that can be written by a TempEntityLayout
+_layout_field_types = {
+    SendPropType.FLOAT: TempEntityFieldType.FLOAT,
+    SendPropType.INT: TempEntityFieldType.INT,
+    SendPropType.VECTOR: TempEntityFieldType.VECTOR,
+}
+
+# Alias types that are written as an index by a TempEntityLayout, and the
+#   class their values must be an instance of (player aliases only need an
+#   index attribute)
+_layout_index_types = {
+    Decal.__name__: Decal,
+    Entity.__name__: Entity,
+    Model.__name__: Model,
+    'Player': None,
+}
+
+
 # ============================================================================
 # >> CLASSES
 # ============================================================================
@@ -77,6 +104,9 @@ class TempEntityTemplate(BaseTempEntity):
         # Get a list to store our hooks...
         self._hooks = list()
 
+        # The native layout is compiled on first use...
+        self._layout = None
+
         # Initialize the base class...
         super()._copy_base(temp_entity, self.size)
 
@@ -141,6 +171,98 @@ class TempEntityTemplate(BaseTempEntity):
             # Add the property...
             self._properties[name] = (prop, offset, type_name)
 
+    def _get_offset(self, alias):
+        """Return the offset of the property of the given alias.
+
+        :param str alias:
+            The name of the alias.
+        :rtype: int
+        """
+        # Get the name of the prop...
+        prop_name = self.aliases.get(alias, None)
+
+        # Is the alias not pointing to a known property?
+        if not isinstance(prop_name, str) or prop_name not in self.properties:
+
+            # Nothing to return...
+            return None
+
+        # Return the offset of the property...
+        return self.properties[prop_name][1]
+
+    def _compile_layout(self):
+        """Compile the aliases into a native layout.
+
+        Aliases whose type can't be written natively (arrays, strings and
+        custom types) are not part of the layout.
+
+        :rtype: TempEntityLayout
+        """
+        # Get a layout matching the size of the temp entity...
+        layout = TempEntityLayout(self.size)
+
+        # Loop through all aliases...
+        for alias, data in self.aliases.items():
+
+            # Is the current alias a section?
+            if isinstance(data, Section):
+
+                # Is the alias a color?
+                if data['type'] == 'Color':
+
+                    # Get the offsets of the color components...
+                    offsets = [self._get_offset(name) for name in data['name']]
+
+                    # Is any of the components unknown?
+                    if None in offsets:
+
+                        # We don't want to add that alias...
+                        continue
+
+                    # Add the color...
+                    layout.add_color(alias, offsets)
+
+                # Otherwise, is the alias written as an index?
+                elif data['type'] in _layout_index_types:
+
+                    # Get the offset of the index...
+                    offset = self._get_offset(data['name'])
+
+                    # Is the index unknown?
+                    if offset is None:
+
+                        # We don't want to add that alias...
+                        continue
+
+                    # Add the index...
+                    layout.add_field(
+                        alias, offset, TempEntityFieldType.INDEX,
+                        _layout_index_types[data['type']])
+
+                # No need to go further...
+                continue
+
+            # Is the alias not pointing to a known property?
+            if data not in self.properties:
+
+                # We don't want to add that alias...
+                continue
+
+            # Get the data of the property...
+            prop, offset, type_name = self.properties[data]
+
+            # Can't the property be written natively?
+            if prop.type not in _layout_field_types:
+
+                # We don't want to add that alias...
+                continue
+
+            # Add the property...
+            layout.add_field(alias, offset, _layout_field_types[prop.type])
+
+        # Return the layout...
+        return layout
+
     @staticmethod
     def _get_type_size(type_name):
         """Helper method returning the size of the given type.
@@ -237,6 +359,21 @@ class TempEntityTemplate(BaseTempEntity):
         """
         return self._hooks
 
+    @property
+    def layout(self):
+        """Return the native layout of the aliases of the temp entity.
+
+        :rtype: TempEntityLayout
+        """
+        # Was the layout not compiled yet?
+        if self._layout is None:
+
+            # Compile the layout...
+            self._layout = self._compile_layout()
+
+        # Return the layout...
+        return self._layout
+
     @property
     def properties(self):
         """Return the properties data of the temp entity.
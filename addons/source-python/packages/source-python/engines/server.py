@@ -12,6 +12,7 @@ from _engines._server import QueryCvarStatus
 from _engines._server import Server
 from _engines._server import engine_server
 from _engines._server import server_game_dll
+from _engines._server import server_game_ents
 from _engines._server import execute_server_command
 from _engines._server import queue_command_string
 from _engines._server import queue_server_command
@@ -38,6 +39,7 @@ __all__ = ('ConnectionlessPacketHandler',
            'insert_command_string',
            'insert_server_command',
            'server_game_dll',
+           'server_game_ents',
            )
 
 
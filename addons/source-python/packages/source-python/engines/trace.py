@@ -28,7 +28,10 @@ from _engines._trace import Surface
 from _engines._trace import SurfaceFlags
 from _engines._trace import TraceFilter
 from _engines._trace import EntityEnumerator
+from _engines._trace import NativeTraceFilter
 from _engines._trace import TraceType
+from _engines._trace import VisibilityMatrix
+from _engines._trace import visibility_matrix
 from _engines._trace import CONTENTS_EMPTY
 from _engines._trace import CONTENTS_SOLID
 from _engines._trace import CONTENTS_WINDOW
@@ -87,6 +90,7 @@ from _engines._trace import MAX_COORD_INTEGER
 from _engines._trace import MAX_COORD_FRACTION
 from _engines._trace import MAX_COORD_FLOAT
 from _engines._trace import MAX_TRACE_LENGTH
+from _engines._trace import TRACE_RESULT_FORMAT
 from _engines._trace import MAX_COORD_RANGE
 from _engines._trace import MIN_COORD_INTEGER
 from _engines._trace import MIN_COORD_FRACTION
@@ -111,13 +115,17 @@ __all__ = ('BaseTrace',
            'MIN_COORD_FLOAT',
            'MIN_COORD_FRACTION',
            'MIN_COORD_INTEGER',
+           'NativeTraceFilter',
            'Ray',
            'Surface',
            'SurfaceFlags',
+           'TRACE_RESULT_FORMAT',
            'TraceFilter',
            'TraceFilterSimple',
            'TraceType',
+           'VisibilityMatrix',
            'engine_trace',
+           'visibility_matrix',
            )
 
 
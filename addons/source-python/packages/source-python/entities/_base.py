@@ -34,8 +34,8 @@ from engines.sound import VOL_NORM
 from engines.trace import engine_trace
 from engines.trace import ContentMasks
 from engines.trace import GameTrace
+from engines.trace import NativeTraceFilter
 from engines.trace import Ray
-from engines.trace import TraceFilterSimple
 #   Entities
 from entities import TakeDamageInfo
 from entities.classes import server_classes
@@ -632,7 +632,7 @@ class Entity(BaseEntity, metaclass=_EntityCaching):
                 ray, mask, BaseEntity(WORLD_ENTITY_INDEX), trace
             )
         else:
-            engine_trace.trace_ray(ray, mask, TraceFilterSimple(
+            engine_trace.trace_ray(ray, mask, NativeTraceFilter(
                 generator()), trace)
 
         # Return whether or not the trace did hit
@@ -0,0 +1,31 @@
+# ../entities/spatial.py
+
+"""Provides a native spatial index of entity bounds.
+
+Example:
+
+.. code:: python
+
+    from entities.entity import Entity
+    from entities.spatial import entity_spatial_index
+
+    for index in entity_spatial_index.entities_in_sphere(
+            origin, 300, 'prop_physics_multiplayer'):
+        Entity(index).take_damage(50)
+"""
+
+# =============================================================================
+# >> FORWARD IMPORTS
+# =============================================================================
+# Source.Python Imports
+#   Entities
+from _entities import EntitySpatialIndex
+from _entities import entity_spatial_index
+
+
+# =============================================================================
+# >> ALL DECLARATION
+# =============================================================================
+__all__ = ('EntitySpatialIndex',
+           'entity_spatial_index',
+           )
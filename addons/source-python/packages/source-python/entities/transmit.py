@@ -0,0 +1,76 @@
+# ../entities/transmit.py
+
+"""Provides native transmit rules."""
+
+# =============================================================================
+# >> IMPORTS
+# =============================================================================
+# Source.Python Imports
+#   Core
+from core import AutoUnload
+#   Engines
+from engines.server import server_game_ents
+#   Memory
+from memory import get_virtual_function
+
+
+# =============================================================================
+# >> FORWARD IMPORTS
+# =============================================================================
+# Source.Python Imports
+#   Entities
+from _entities import TransmitManager
+from _entities import _TransmitRules
+from _entities import transmit_manager
+
+
+# =============================================================================
+# >> ALL DECLARATION
+# =============================================================================
+__all__ = ('TransmitManager',
+           'TransmitRules',
+           'transmit_manager',
+           )
+
+
+# =============================================================================
+# >> INITIALIZATION
+# =============================================================================
+# The rules are applied after the game has built the transmit list of a client
+transmit_manager.initialize(
+    get_virtual_function(server_game_ents, 'CheckTransmit'))
+
+
+# =============================================================================
+# >> CLASSES
+# =============================================================================
+class TransmitRules(AutoUnload, _TransmitRules):
+    """Class used to add native transmit rules for a plugin.
+
+    Each instance owns a native rule set. The rules are applied in C++
+    without calling Python, combined with the rules of all other instances
+    and :data:`transmit_manager`. Removing a rule only affects this
+    instance. Rules of deleted entities and disconnected players are removed
+    automatically, and all rules are removed when the plugin is unloaded.
+
+    Example:
+
+    .. code:: python
+
+        from entities.transmit import TransmitRules
+
+        rules = TransmitRules()
+
+        # Hide entity 70 from player 1
+        rules.hide(70, 1)
+
+        # Hide the players of team 2 from each other
+        rules.set_team_hidden(2, 2)
+
+        # Hide all chickens
+        rules.hide_classname('chicken')
+    """
+
+    def _unload_instance(self):
+        """Remove all rules of this instance."""
+        self.clear()
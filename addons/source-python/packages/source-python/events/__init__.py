@@ -21,6 +21,7 @@ from loggers import _sp_logger
 #   Events
 from _events import EventVarType
 from _events import GameEvent
+from _events import GameEventAccessor
 from _events import GameEventDescriptor
 
 
@@ -30,6 +31,7 @@ from _events import GameEventDescriptor
 __all__ = ('Event',
            'EventVarType',
            'GameEvent',
+           'GameEventAccessor',
            'GameEventDescriptor',
            )
 
@@ -0,0 +1,98 @@
+# ../events/recorder.py
+
+"""Provides native recording of game events to a file."""
+
+# =============================================================================
+# >> IMPORTS
+# =============================================================================
+# Source.Python Imports
+#   Core
+from core import AutoUnload
+
+
+# =============================================================================
+# >> FORWARD IMPORTS
+# =============================================================================
+# Source.Python Imports
+#   Events
+from _events import GameEventRecorder
+
+
+# =============================================================================
+# >> ALL DECLARATION
+# =============================================================================
+__all__ = ('EventRecorder',
+           'GameEventRecorder',
+           )
+
+
+# =============================================================================
+# >> CLASSES
+# =============================================================================
+class EventRecorder(AutoUnload):
+    """Records game events as JSON lines without calling Python per event.
+
+    The recorder is stopped automatically when the plugin is unloaded.
+    """
+
+    def __init__(self, path, *event_names, **kwargs):
+        """Store the recorder's settings.
+
+        :param str path:
+            Path of the file to write to.
+        :param str event_names:
+            Names of the events to record.
+        :param kwargs:
+            Additional arguments passed to :meth:`GameEventRecorder.start`.
+        """
+        if not event_names:
+            raise ValueError('At least one event name is required.')
+
+        self.path = str(path)
+        self.event_names = event_names
+        self.kwargs = kwargs
+        self.recorder = GameEventRecorder()
+
+    def start(self):
+        """Start recording the events."""
+        self.recorder.start(self.path, self.event_names, **self.kwargs)
+
+    def stop(self):
+        """Stop recording and write all pending events."""
+        self.recorder.stop()
+
+    @property
+    def is_running(self):
+        """Return True if the recorder is running.
+
+        :rtype: bool
+        """
+        return self.recorder.is_running
+
+    @property
+    def dropped(self):
+        """Return the number of events that have been dropped.
+
+        :rtype: int
+        """
+        return self.recorder.dropped
+
+    @property
+    def lost(self):
+        """Return the number of events that could not be written to disk.
+
+        :rtype: int
+        """
+        return self.recorder.lost
+
+    @property
+    def recorded(self):
+        """Return the number of events that have been recorded.
+
+        :rtype: int
+        """
+        return self.recorder.recorded
+
+    def _unload_instance(self):
+        """Stop the recorder."""
+        self.recorder.stop()
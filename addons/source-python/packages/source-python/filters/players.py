@@ -22,7 +22,9 @@ from filters.iterator import _IterObject
 #   Paths
 from paths import SP_DATA_PATH
 #   Players
+from players import PlayerFilterMask
 from players import PlayerGenerator
+from players import get_team_filter_mask
 from players.entity import Player
 from players.helpers import index_from_userid
 
@@ -31,6 +33,7 @@ from players.helpers import index_from_userid
 # >> ALL DECLARATION
 # =============================================================================
 __all__ = ('get_default_filters',
+           'get_filter_masks',
            'parse_filter',
            'PlayerIter',
            )
@@ -42,6 +45,19 @@ __all__ = ('get_default_filters',
 # Get the team's file for the current game
 _game_teams = ConfigObj(SP_DATA_PATH / 'teams' / GAME_NAME + '.ini')
 
+# Native filter masks of the built-in filters
+_filter_masks = {
+    'all': 0,
+    'bot': PlayerFilterMask.BOT,
+    'human': PlayerFilterMask.HUMAN,
+    'alive': PlayerFilterMask.ALIVE,
+    'dead': PlayerFilterMask.DEAD,
+}
+
+# Callbacks of the built-in filters. The native masks are only used as long
+# as these callbacks are registered.
+_builtin_filters = {}
+
 
 # =============================================================================
 # >> PLAYER ITERATION CLASSES
@@ -58,6 +74,70 @@ class PlayerIter(_IterObject):
             # Yield the Player instance for the current edict
             yield Player(index_from_edict(edict))
 
+    def __iter__(self):
+        """Iterate over all players matching the filters.
+
+        Built-in filters are evaluated natively, so Python filters are only
+        called for players that passed the built-in filters.
+        """
+        # Sub-classes might use another iterator
+        if type(self).iterator is not PlayerIter.iterator:
+            yield from super().__iter__()
+            return
+
+        is_mask, is_filters = self._compile_filters(self.is_filters)
+        not_mask, not_filters = self._compile_filters(self.not_filters)
+
+        for edict in PlayerGenerator(is_mask, not_mask):
+            player = Player(index_from_edict(edict))
+            if self._is_valid_python(player, is_filters, not_filters):
+                yield player
+
+    def indexes(self):
+        """Iterate over the indexes of all players matching the filters.
+
+        :class:`players.entity.Player` objects are only created if Python
+        filters need to be called.
+        """
+        if type(self).iterator is PlayerIter.iterator:
+            is_mask, is_filters = self._compile_filters(self.is_filters)
+            not_mask, not_filters = self._compile_filters(self.not_filters)
+
+            if not is_filters and not not_filters:
+                for edict in PlayerGenerator(is_mask, not_mask):
+                    yield index_from_edict(edict)
+
+                return
+
+        for player in self:
+            yield player.index
+
+    def _compile_filters(self, filter_names):
+        """Split the given filters into a native mask and Python filters."""
+        mask = 0
+        python_filters = []
+        for filter_name in filter_names:
+            # Only use the mask if the built-in filter hasn't been replaced
+            if _is_builtin_filter(self._filters, filter_name):
+                mask |= int(_filter_masks[filter_name])
+            else:
+                python_filters.append(filter_name)
+
+        return mask, python_filters
+
+    def _is_valid_python(self, player, is_filters, not_filters):
+        """Return whether the player passes the given Python filters."""
+        for filter_name in is_filters:
+            if (filter_name not in self._filters or not
+                    self._filters[filter_name](player)):
+                return False
+
+        for filter_name in not_filters:
+            if self._filters[filter_name](player):
+                return False
+
+        return True
+
 
 # =============================================================================
 # PLAYER TEAM CLASSES
@@ -92,12 +172,30 @@ class _Team(object):
 # =============================================================================
 # >> FILTER REGISTRATION
 # =============================================================================
+def _register_builtin_filter(filter_name, function):
+    """Register a built-in filter and remember its callback."""
+    PlayerIter.register_filter(filter_name, function)
+    _builtin_filters[filter_name] = function
+
+def _is_builtin_filter(filters, filter_name):
+    """Return whether the filter still uses its built-in callback and mask."""
+    function = _builtin_filters.get(filter_name)
+    return (
+        function is not None and filter_name in _filter_masks and
+        filters.get(filter_name) is function)
+
+def _add_team_filter_mask(team_name, team):
+    """Store the native filter mask of the given team if there is one."""
+    mask = get_team_filter_mask(team)
+    if mask:
+        _filter_masks[team_name] = mask
+
 # Register the filter functions
-PlayerIter.register_filter('all', lambda player: True)
-PlayerIter.register_filter('bot', lambda player: player.is_bot())
-PlayerIter.register_filter('human', lambda player: not player.is_bot())
-PlayerIter.register_filter('alive', lambda player: not player.dead)
-PlayerIter.register_filter('dead', lambda player: player.dead)
+_register_builtin_filter('all', lambda player: True)
+_register_builtin_filter('bot', lambda player: player.is_bot())
+_register_builtin_filter('human', lambda player: not player.is_bot())
+_register_builtin_filter('alive', lambda player: not player.dead)
+_register_builtin_filter('dead', lambda player: player.dead)
 
 # Loop through all teams in the game's team file
 for _team in _game_teams.get('names', {}):
@@ -106,8 +204,9 @@ for _team in _game_teams.get('names', {}):
     _player_teams[_team] = int(_game_teams['names'][_team])
 
     # Register the filter
-    PlayerIter.register_filter(
+    _register_builtin_filter(
         _team, _player_teams[_team]._player_is_on_team)
+    _add_team_filter_mask(_team, _player_teams[_team].team)
 
 # Loop through all base team names
 for _number, _team in enumerate(('un', 'spec', 't', 'ct')):
@@ -122,8 +221,9 @@ for _number, _team in enumerate(('un', 'spec', 't', 'ct')):
     _player_teams[_team] = _number
 
     # Register the filter
-    PlayerIter.register_filter(
+    _register_builtin_filter(
         _team, _player_teams[_team]._player_is_on_team)
+    _add_team_filter_mask(_team, _number)
 
 
 # =============================================================================
@@ -145,6 +245,26 @@ def parse_filter(expr, filters=None):
 
     return _parse_node(ast.parse(expr, mode='eval').body, filters)
 
+def get_filter_masks(is_filters, not_filters):
+    """Return the native masks of the given :class:`PlayerIter` filters.
+
+    :param iterable is_filters: The "is" filter names.
+    :param iterable not_filters: The "not" filter names.
+    :return: A tuple containing the "is" and "not" mask or ``None`` if one
+        of the filters is not a built-in filter, or has been replaced or
+        unregistered.
+    :rtype: tuple
+    """
+    masks = [0, 0]
+    for position, filter_names in enumerate((is_filters, not_filters)):
+        for filter_name in filter_names:
+            if not _is_builtin_filter(PlayerIter._filters, filter_name):
+                return None
+
+            masks[position] |= int(_filter_masks[filter_name])
+
+    return tuple(masks)
+
 def get_default_filters():
     """Return the default filters (all available filters)."""
     return dict((name, set(PlayerIter(name))) for name in PlayerIter.filters)
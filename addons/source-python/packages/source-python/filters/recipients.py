@@ -64,6 +64,25 @@ class RecipientFilter(_RecipientFilter):
 
     def merge(self, iterable):
         """Merge the given recipient."""
+        # Imported here to avoid circular imports
+        from filters.players import PlayerIter
+        from filters.players import get_filter_masks
+
+        # Merge other recipient filters natively
+        if isinstance(iterable, BaseRecipientFilter):
+            self.merge_recipients(iterable)
+            return
+
+        # Evaluate built-in player filters natively. Sub-classes have their
+        # own filters, so only PlayerIter itself can be handled.
+        if type(iterable) is PlayerIter:
+            masks = get_filter_masks(
+                iterable.is_filters, iterable.not_filters)
+
+            if masks is not None:
+                self.add_players(*masks)
+                return
+
         # Loop through all indexes of the given recipient
         for index in iterable:
 
@@ -74,6 +74,8 @@ from _listeners import on_tick_listener_manager
 from _listeners import on_server_output_listener_manager
 from _listeners import on_player_run_command_listener_manager
 from _listeners import on_button_state_changed_listener_manager
+from _listeners import on_player_run_command_fields_listener_manager
+from _listeners import UserCmdField
 
 
 # =============================================================================
@@ -110,6 +112,7 @@ __all__ = ('ButtonStatus',
            'OnNetworkidValidated',
            'OnButtonStateChanged',
            'OnPlayerRunCommand',
+           'OnPlayerRunCommandFields',
            'OnPluginLoaded',
            'OnPluginLoading',
            'OnPluginUnloaded',
@@ -119,6 +122,7 @@ __all__ = ('ButtonStatus',
            'OnTick',
            'OnVersionUpdate',
            'OnServerOutput',
+           'UserCmdField',
            'get_button_combination_status',
            'on_client_active_listener_manager',
            'on_client_connect_listener_manager',
@@ -155,6 +159,7 @@ __all__ = ('ButtonStatus',
            'on_version_update_listener_manager',
            'on_server_output_listener_manager',
            'on_player_run_command_listener_manager',
+           'on_player_run_command_fields_listener_manager',
            'on_button_state_changed_listener_manager',
            )
 
@@ -502,6 +507,58 @@ class OnButtonStateChanged(ListenerManagerDecorator):
     manager = on_button_state_changed_listener_manager
 
 
+class OnPlayerRunCommandFields(AutoUnload):
+    """Register/unregister a run command listener for specific fields.
+
+    The listener is called with the player index, followed by the requested
+    fields in the order of their :class:`UserCmdField` bits. No
+    :class:`players.entity.Player` or :class:`players.UserCmd` objects are
+    created, so changing the passed values has no effect.
+
+    Example:
+
+    .. code:: python
+
+        @OnPlayerRunCommandFields(UserCmdField.VIEW_ANGLES|UserCmdField.BUTTONS)
+        def on_player_run_command(index, view_angles, buttons):
+            ...
+    """
+
+    def __init__(self, fields):
+        """Store the requested fields."""
+        self.fields = fields
+        self.callback = None
+
+    def __call__(self, callback):
+        """Store the callback and register the listener."""
+        # Is the callback callable?
+        if not callable(callback):
+
+            # Raise an error
+            raise TypeError(
+                "'" + type(callback).__name__ + "' object is not callable.")
+
+        # Store the callback
+        self.callback = callback
+
+        # Register the listener
+        on_player_run_command_fields_listener_manager.register_listener(
+            self.callback, int(self.fields))
+
+        # Return the callback
+        return self.callback
+
+    def _unload_instance(self):
+        """Unregister the listener."""
+        # Was the callback registered?
+        if self.callback is None:
+            return
+
+        # Unregister the listener
+        on_player_run_command_fields_listener_manager.unregister_listener(
+            self.callback)
+
+
 class OnServerOutput(ListenerManagerDecorator):
     """Register/unregister a server output listener."""
 
@@ -13,6 +13,10 @@ from _mathlib import Quaternion
 from _mathlib import Plane
 from _mathlib import RadianEuler
 from _mathlib import Matrix3x4
+from _mathlib import VectorArray
+from _mathlib import get_free_list_stats
+from _mathlib import is_free_list_enabled
+from _mathlib import set_free_list_enabled
 
 
 # =============================================================================
@@ -29,6 +33,10 @@ __all__ = ('NULL_MATRIX',
            'Quaternion',
            'RadianEuler',
            'Vector',
+           'VectorArray',
+           'get_free_list_stats',
+           'is_free_list_enabled',
+           'set_free_list_enabled',
            )
 
 
@@ -22,6 +22,7 @@ from messages.base import Fade
 from messages.base import HudMsg
 from messages.base import UserMessageCreator
 from messages.base import UserMessage
+from messages.base import PreparedUserMessage
 from messages.dialog import DialogAskConnect
 from messages.dialog import DialogEntry
 from messages.dialog import DialogMenu
@@ -60,6 +61,7 @@ __all__ = ('DialogAskConnect',
            'HudDestination',
            'HudMsg',
            'KeyHintText',
+           'PreparedUserMessage',
            'ResetHUD',
            'SayText',
            'SayText2',
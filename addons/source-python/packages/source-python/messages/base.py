@@ -25,6 +25,7 @@ from translations.strings import TranslationStrings
 # ============================================================================
 #   Messages
 from _messages import UserMessage
+from _messages import PreparedUserMessage
 from _messages import SCREENFADE_FRACBITS
 from _messages import ShakeCommand
 from _messages import HudDestination
@@ -44,10 +45,20 @@ class AttrDict(dict):
 class UserMessageCreator(AttrDict):
     """Provide an easy interface to create user messages.
 
+    The encoded payload is cached per language and token set, so sending
+    the same message again only replays the encoded bytes. The cache is
+    reset when a field is assigned, but it can't notice changes made to a
+    field value in place (e.g. appending to a list or updating a
+    :class:`translations.strings.TranslationStrings` object). Call
+    :meth:`reset_cache` after such a change, or the previously encoded
+    payload is sent again.
+
     :attr bool reliable: Whether to send message using reliable channel.
+    :attr int max_prepared_messages: The maximum number of cached payloads.
     """
 
     reliable = False
+    max_prepared_messages = 32
 
     def __init__(self, **kwargs):
         """Initialize the usermessage creator.
@@ -55,6 +66,7 @@ class UserMessageCreator(AttrDict):
         :param dict kwargs: All valid fields.
         """
         super().__setattr__('valid_fields', kwargs.keys())
+        super().__setattr__('_prepared_messages', {})
         super().__init__(kwargs)
 
     def __setitem__(self, item, value):
@@ -63,38 +75,67 @@ class UserMessageCreator(AttrDict):
             raise NameError('Invalid field name "{0}".'.format(item))
 
         super().__setitem__(item, value)
+        self.reset_cache()
+
+    def reset_cache(self):
+        """Remove all cached payloads.
+
+        This must be called after a field value has been modified in place.
+        """
+        self._prepared_messages.clear()
 
     def __setattr__(self, attr, value):
         """Set a field value."""
         self[attr] = value
 
     def send(self, *player_indexes, **tokens):
-        """Send the user message."""
+        """Send the user message.
+
+        .. note::
+
+            Cached payloads are reused. See :meth:`reset_cache`.
+        """
         player_indexes = RecipientFilter(*player_indexes)
         for language, indexes in self._categorize_players_by_language(
                 player_indexes).items():
-            translated_kwargs = AttrDict(self)
-            translated_kwargs.update(
-                self._get_translated_kwargs(language, tokens))
-            self._send(indexes, translated_kwargs)
+            recipients = RecipientFilter(*indexes)
+            recipients.reliable = self.reliable
+            self._get_prepared_message(language, tokens).send(recipients)
 
-    def _send(self, player_indexes, translated_kwargs):
-        """Send the user message to the given players.
+    def _get_prepared_message(self, language, tokens):
+        """Return the encoded user message for the given language.
 
-        :param iterable player_indexes: All players with the same language
-            setting.
-        :param AttrDict translated_kwargs: The translated arguments.
+        :param str language: The language to translate the fields to.
+        :param dict tokens: The tokens to format the fields with.
+        :rtype: PreparedUserMessage
         """
-        recipients = RecipientFilter(*player_indexes)
-        recipients.reliable = self.reliable
-        user_message = UserMessage(recipients, self.message_name)
-
-        if user_message.is_protobuf():
-            self.protobuf(user_message.buffer, translated_kwargs)
+        try:
+            key = (language, frozenset(tokens.items()))
+            prepared = self._prepared_messages.get(key)
+        except TypeError:
+            # Unhashable token values can't be cached
+            key = prepared = None
+
+        if prepared is not None:
+            return prepared
+
+        translated_kwargs = AttrDict(self)
+        translated_kwargs.update(
+            self._get_translated_kwargs(language, tokens))
+
+        prepared = PreparedUserMessage(self.message_name)
+        if prepared.is_protobuf():
+            self.protobuf(prepared.buffer, translated_kwargs)
         else:
-            self.bitbuf(user_message.buffer, translated_kwargs)
+            self.bitbuf(prepared.buffer, translated_kwargs)
+
+        if key is not None:
+            if len(self._prepared_messages) >= self.max_prepared_messages:
+                self._prepared_messages.clear()
 
-        user_message.send()
+            self._prepared_messages[key] = prepared
+
+        return prepared
 
     @staticmethod
     def _categorize_players_by_language(player_indexes):
@@ -492,30 +533,28 @@ class HudMsg(UserMessageCreator):
 
     def protobuf(self, buffer, kwargs):
         """Send the HudMsg with protobuf."""
-        buffer.set_int32('channel', kwargs.channel)
-
-        pos_buffer = buffer.mutable_message('pos')
-        pos_buffer.set_float('x', kwargs.x)
-        pos_buffer.set_float('y', kwargs.y)
-
-        color1_buffer = buffer.mutable_message('clr1')
-        color1_buffer.set_int32('r', kwargs.color1.r)
-        color1_buffer.set_int32('g', kwargs.color1.g)
-        color1_buffer.set_int32('b', kwargs.color1.b)
-        color1_buffer.set_int32('a', kwargs.color1.a)
-
-        color2_buffer = buffer.mutable_message('clr2')
-        color2_buffer.set_int32('r', kwargs.color2.r)
-        color2_buffer.set_int32('g', kwargs.color2.g)
-        color2_buffer.set_int32('b', kwargs.color2.b)
-        color2_buffer.set_int32('a', kwargs.color2.a)
-
-        buffer.set_int32('effect', kwargs.effect)
-        buffer.set_float('fade_in_time', kwargs.fade_in)
-        buffer.set_float('fade_out_time', kwargs.fade_out)
-        buffer.set_float('hold_time', kwargs.hold_time)
-        buffer.set_float('fx_time', kwargs.fx_time)
-        buffer.set_string('text', kwargs.message)
+        buffer.set_fields({
+            'channel': kwargs.channel,
+            'pos': {'x': kwargs.x, 'y': kwargs.y},
+            'clr1': {
+                'r': kwargs.color1.r,
+                'g': kwargs.color1.g,
+                'b': kwargs.color1.b,
+                'a': kwargs.color1.a,
+            },
+            'clr2': {
+                'r': kwargs.color2.r,
+                'g': kwargs.color2.g,
+                'b': kwargs.color2.b,
+                'a': kwargs.color2.a,
+            },
+            'effect': kwargs.effect,
+            'fade_in_time': kwargs.fade_in,
+            'fade_out_time': kwargs.fade_out,
+            'hold_time': kwargs.hold_time,
+            'fx_time': kwargs.fx_time,
+            'text': kwargs.message,
+        })
 
     def bitbuf(self, buffer, kwargs):
         """Send the HudMsg with bitbuf."""
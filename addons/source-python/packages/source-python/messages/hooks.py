@@ -22,7 +22,6 @@ from engines.server import engine_server
 from filters.recipients import BaseRecipientFilter
 from filters.recipients import RecipientFilter
 #   Bitbuffers
-from bitbuffers import BitBufferWrite
 from bitbuffers import BitBufferRead
 #   Listeners
 from listeners import ListenerManager
@@ -32,7 +31,6 @@ from memory import get_object_pointer
 from memory import get_size
 from memory import get_virtual_function
 from memory.hooks import PreHook
-from memory.hooks import PostHook
 #   Messages
 from messages import UserMessage
 from messages import get_message_index
@@ -41,6 +39,8 @@ from messages.impl import get_user_message_impl
 
 if UserMessage.is_protobuf():
     from _messages import ProtobufMessage
+else:
+    from _messages import user_message_hook_manager
 
 
 # =============================================================================
@@ -57,7 +57,6 @@ __all__ = (
 # =============================================================================
 # >> GLOBAL VARIABLES
 # =============================================================================
-_user_message_data = None
 _recipients = RecipientFilter()
 
 
@@ -107,6 +106,7 @@ class HookUserMessageBase(AutoUnload):
 
         self.callback = callback
         self.hooks[self.message_index].register_listener(callback)
+        _update_hooked_state(self.message_index)
         return self.callback
 
     def _unload_instance(self):
@@ -115,6 +115,7 @@ class HookUserMessageBase(AutoUnload):
             return
 
         self.hooks[self.message_index].unregister_listener(self.callback)
+        _update_hooked_state(self.message_index)
 
     @property
     def hooks(self):
@@ -158,6 +159,21 @@ class HookUserMessage(HookUserMessageBase):
         self.impl = get_user_message_impl(self.message_index)
 
 
+# =============================================================================
+# >> FUNCTIONS
+# =============================================================================
+def _update_hooked_state(message_index):
+    """Tell the native hook whether the given message index is hooked."""
+    # Protobuf messages are hooked in Python
+    if UserMessage.is_protobuf():
+        return
+
+    user_message_hook_manager.set_hooked(
+        message_index,
+        bool(HookUserMessage.hooks[message_index] or
+             HookBitBufferUserMessage.hooks[message_index]))
+
+
 # =============================================================================
 # >> HOOKS
 # =============================================================================
@@ -207,34 +223,8 @@ if UserMessage.is_protobuf():
             impl.write(buffer, data)
 
 else:
-    @PreHook(get_virtual_function(engine_server, 'UserMessageBegin'))
-    def _pre_user_message_begin(args):
-        try:
-            # Replace original recipients filter
-            tmp_recipients = make_object(BaseRecipientFilter, args[1])
-            _recipients.update(*tuple(tmp_recipients), clear=True)
-        except RuntimeError:
-            # Patch for issue #314
-            tmp_recipients = RecipientFilter()
-            (args[1] + 4).copy(get_object_pointer(tmp_recipients) + 4,
-                get_size(RecipientFilter) - 4)
-            _recipients.update(*tuple(tmp_recipients), clear=True)
-        args[1] = _recipients
-
-    @PostHook(get_virtual_function(engine_server, 'UserMessageBegin'))
-    def _post_user_message_begin(args, return_value):
-        global _user_message_data
-        _user_message_data = (args[2], return_value)
-
-    @PreHook(get_virtual_function(engine_server, 'MessageEnd'))
-    def _pre_message_end(args):
-        # This happens when we initialize our hooks, while a user message is
-        # currently being created
-        if _user_message_data is None:
-            return
-
-        message_index, buffer_write_ptr = _user_message_data
-
+    def _on_user_message_end(message_index, recipients, buffer_write):
+        """Called by the native hook before a hooked message is sent."""
         # Retrieve the ListenerManager instances
         user_message_hooks = HookUserMessage.hooks[message_index]
         bitbuffer_user_message_hooks = HookBitBufferUserMessage.hooks[message_index]
@@ -243,7 +233,6 @@ else:
         if not user_message_hooks and not bitbuffer_user_message_hooks:
             return
 
-        buffer_write = make_object(BitBufferWrite, buffer_write_ptr)
         buffer_read = BitBufferRead(buffer_write, False)
 
         org_current_bit = buffer_write.current_bit
@@ -253,7 +242,7 @@ else:
         for callback in bitbuffer_user_message_hooks:
             buffer_read.seek_to_bit(0)
             buffer_write.seek_to_bit(0)
-            callback(_recipients, buffer_read, buffer_write)
+            callback(recipients, buffer_read, buffer_write)
 
         # If none of the above callbacks wrote to the buffer, we need to restore
         # the current_bit to the original value.
@@ -271,9 +260,16 @@ else:
 
         buffer_read.seek_to_bit(0)
         data = impl.read(buffer_read)
-        user_message_hooks.notify(_recipients, data)
+        user_message_hooks.notify(recipients, data)
 
         # Update buffer if data has been changed
         if data.has_been_changed():
             buffer_write.seek_to_bit(0)
-            impl.write(buffer_write, data)
\ No newline at end of file
+            impl.write(buffer_write, data)
+
+    # Only messages that have been marked as hooked enter Python
+    user_message_hook_manager.initialize(
+        get_virtual_function(engine_server, 'UserMessageBegin'),
+        get_virtual_function(engine_server, 'MessageEnd'),
+        _recipients,
+        _on_user_message_end)
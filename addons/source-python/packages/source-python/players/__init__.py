@@ -16,9 +16,18 @@ from loggers import _sp_logger
 # Source.Python Imports
 #   Players
 from _players import Client
+from _players import PlayerFilterMask
 from _players import PlayerGenerator
 from _players import PlayerInfo
+from _players import PlayerStateField
+from _players import PlayerStateTable
 from _players import UserCmd
+from _players import UserCmdRule
+from _players import UserCmdRuleField
+from _players import UserCmdRuleManager
+from _players import get_team_filter_mask
+from _players import player_state_table
+from _players import user_cmd_rule_manager
 
 
 # =============================================================================
@@ -26,9 +35,18 @@ from _players import UserCmd
 # =============================================================================
 __all__ = ('BaseClient',
            'Client',
+           'PlayerFilterMask',
            'PlayerGenerator',
            'PlayerInfo',
+           'PlayerStateField',
+           'PlayerStateTable',
            'UserCmd',
+           'UserCmdRule',
+           'UserCmdRuleField',
+           'UserCmdRuleManager',
+           'get_team_filter_mask',
+           'player_state_table',
+           'user_cmd_rule_manager',
            )
 
 
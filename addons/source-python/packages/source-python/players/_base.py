@@ -33,8 +33,8 @@ from engines.trace import engine_trace
 from engines.trace import ContentMasks
 from engines.trace import GameTrace
 from engines.trace import MAX_TRACE_LENGTH
+from engines.trace import NativeTraceFilter
 from engines.trace import Ray
-from engines.trace import TraceFilterSimple
 #   Entities
 from entities import ServerClassGenerator
 from entities.constants import CollisionGroup
@@ -287,7 +287,7 @@ class Player(PlayerMixin, Entity):
             Will be passed to the trace filter.
         :param TraceFilter trace_filter:
             The trace filter to use. If ``None`` was given
-            :class:`engines.trace.TraceFilterSimple` will be used.
+            :class:`engines.trace.NativeTraceFilter` will be used.
         :rtype: GameTrace
         """
         # Get the eye location of the player
@@ -301,8 +301,8 @@ class Player(PlayerMixin, Entity):
 
         # Start the trace
         engine_trace.trace_ray(
-            Ray(start_vec, end_vec), mask, TraceFilterSimple(
-                (self,)) if trace_filter is None else trace_filter,
+            Ray(start_vec, end_vec), mask, NativeTraceFilter(
+                (self.index,)) if trace_filter is None else trace_filter,
             trace
         )
 
@@ -0,0 +1,90 @@
+# ../players/rules.py
+
+"""Provides native CUserCmd rewriting rules."""
+
+# =============================================================================
+# >> IMPORTS
+# =============================================================================
+# Source.Python Imports
+#   Core
+from core import AutoUnload
+#   Players
+from players import user_cmd_rule_manager
+
+
+# =============================================================================
+# >> ALL DECLARATION
+# =============================================================================
+__all__ = ('UserCmdRules',
+           )
+
+
+# =============================================================================
+# >> CLASSES
+# =============================================================================
+class UserCmdRules(AutoUnload):
+    """Class used to add native CUserCmd rules for a plugin.
+
+    The rules are applied in C++ before any run command listener is called.
+    They are removed when the plugin is unloaded.
+
+    Example:
+
+    .. code:: python
+
+        from players.constants import PlayerButtons
+        from players.rules import UserCmdRules
+        from players import UserCmdRuleField
+
+        rules = UserCmdRules()
+
+        # Block auto ducking
+        no_duck = rules.add_button_mask(PlayerButtons.DUCK)
+
+        # Limit the pitch
+        rules.add_clamp(UserCmdRuleField.PITCH, -45, 45)
+
+        # Allow player 1 to duck
+        no_duck.set_enabled(1, False)
+    """
+
+    def __init__(self):
+        """Initialize the rule list."""
+        self._rules = []
+
+    def add_button_mask(self, buttons):
+        """Add a rule that removes the given buttons from every command.
+
+        :param int buttons: The buttons to remove.
+        :rtype: UserCmdRule
+        """
+        rule = user_cmd_rule_manager.add_button_mask(buttons)
+        self._rules.append(rule)
+        return rule
+
+    def add_clamp(self, field, min, max):
+        """Add a rule that clamps the given field of every command.
+
+        :param UserCmdRuleField field: The field to clamp.
+        :param float min: The minimum value.
+        :param float max: The maximum value.
+        :rtype: UserCmdRule
+        """
+        rule = user_cmd_rule_manager.add_clamp(field, min, max)
+        self._rules.append(rule)
+        return rule
+
+    def remove_rule(self, rule):
+        """Remove the given rule.
+
+        :param UserCmdRule rule: The rule to remove.
+        """
+        self._rules.remove(rule)
+        user_cmd_rule_manager.remove_rule(rule)
+
+    def _unload_instance(self):
+        """Remove all rules of this instance."""
+        for rule in self._rules:
+            user_cmd_rule_manager.remove_rule(rule)
+
+        self._rules.clear()
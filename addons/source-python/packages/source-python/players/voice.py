@@ -7,41 +7,83 @@
 # >> IMPORTS
 # =============================================================================
 # Python
-import collections
+from collections.abc import Mapping
 
 # Source.Python
 #    Engines
 from engines.server import global_vars
-#    Listeners
-from listeners import OnClientDisconnect
 #    Memory
 import memory
 
-from memory.hooks import PreHook
-
 
 # =============================================================================
 # >> FORWARD IMPORTS
 # =============================================================================
 # Source.Python Imports
 #  Voice
+from _players._voice import VoiceMatrix
+from _players._voice import voice_matrix
 from _players._voice import voice_server
 
 
 # =============================================================================
 # >> ALL DECLARATION
 # =============================================================================
-__all__ = ('_MuteManager',
+__all__ = ('VoiceMatrix',
+           '_MuteManager',
            'mute_manager',
+           'voice_matrix',
            'voice_server',
            )
 
 
+# =============================================================================
+# >> INITIALIZATION
+# =============================================================================
+# The voice rules are applied before the engine updates the listen state
+voice_matrix.initialize(
+    memory.get_virtual_function(voice_server, 'SetClientListening'))
+
+
 # =============================================================================
 # >> CLASSES
 # =============================================================================
-class _MuteManager(collections.defaultdict):
-    """A singleton that manages muting players."""
+class _MuteManager(Mapping):
+    """A singleton that manages muting players.
+
+    The mutes are stored in :data:`voice_matrix`, so checking them doesn't
+    call Python for every voice packet.
+
+    The manager is a read-only mapping of receiver indexes to a frozenset of
+    the senders they can't hear. Previously, it was a ``defaultdict(set)``
+    whose sets could be edited directly. Use :meth:`mute_player` and
+    :meth:`unmute_player` instead.
+    """
+
+    def __getitem__(self, receiver):
+        """Return the senders the given receiver can't hear.
+
+        :param int receiver: The index of the receiver.
+        :rtype: frozenset
+        :raise KeyError: Raised if the index is not a valid player slot.
+        """
+        try:
+            return frozenset(voice_matrix.get_muted_senders(receiver))
+        except (IndexError, OverflowError, TypeError):
+            raise KeyError(receiver)
+
+    def __iter__(self):
+        """Iterate over all receivers that have muted senders."""
+        for receiver in range(1, global_vars.max_clients + 1):
+            if voice_matrix.get_muted_senders(receiver):
+                yield receiver
+
+    def __len__(self):
+        """Return the number of receivers that have muted senders.
+
+        :rtype: int
+        """
+        return sum(1 for receiver in self)
 
     @staticmethod
     def _get_receivers(receivers):
@@ -75,8 +117,7 @@ class _MuteManager(collections.defaultdict):
         that contains the player indexes that shouldn't hear the sender
         anymore.
         """
-        for receiver in self._get_receivers(receivers):
-            self[receiver].add(sender)
+        voice_matrix.mute(sender, self._get_receivers(receivers))
 
     def unmute_player(self, sender, receivers=None):
         """Unmute a player, so other players can hear him again.
@@ -88,8 +129,7 @@ class _MuteManager(collections.defaultdict):
         tuple that contains the player indexes that should hear the sender
         again.
         """
-        for receiver in self._get_receivers(receivers):
-            self[receiver].discard(sender)
+        voice_matrix.unmute(sender, self._get_receivers(receivers))
 
     def is_muted(self, sender, receivers=None):
         """Return True if a player is muted.
@@ -100,30 +140,7 @@ class _MuteManager(collections.defaultdict):
         If you want to check if the player is muted only for specific players,
         pass a tuple that contains the player indexes that should be checked.
         """
-        return all(map(
-            lambda receiver: sender in self[receiver],
-            self._get_receivers(receivers)))
+        return voice_matrix.is_muted(sender, self._get_receivers(receivers))
 
 # The singleton object of the :class:`_MuteManager` class
-mute_manager = _MuteManager(set)
-
-
-# =============================================================================
-# >> CALLBACKS
-# =============================================================================
-@PreHook(memory.get_virtual_function(voice_server, 'SetClientListening'))
-def _pre_set_client_listening(args):
-    """Called before IVoiceServer::SetClientListening is called."""
-    receiver = args[1]
-    sender = args[2]
-
-    # Check if the sender is muted for this receiver
-    if mute_manager.is_muted(sender, [receiver]):
-        args[3] = False
-
-
-@OnClientDisconnect
-def _on_client_disconnect(index):
-    """Called when a player left the server."""
-    # Unmute the player, so the next player who gets this index won't be muted
-    mute_manager.unmute_player(index)
+mute_manager = _MuteManager()
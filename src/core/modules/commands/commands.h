@@ -29,9 +29,12 @@
 //-----------------------------------------------------------------------------
 // Includes.
 //-----------------------------------------------------------------------------
+#include <string>
+#include <ctype.h>
 #include "utilities/wrap_macros.h"
 #include "convar.h"
 #include "utilities/ipythongenerator.h"
+#include "utilities/string_hash.h"
 #include "boost/typeof/typeof.hpp" 
 
 
@@ -65,6 +68,14 @@ bool find_manager(InputMap& input, const char* name, Result& result)
 }
 
 
+template<class InputMap, class Result>
+bool find_manager_fast(InputMap& input, const char* name, Result& result)
+{
+	result = input.find(name, StringHashNoCase(), StringEqualNoCase());
+	return result != input.end();
+}
+
+
 //-----------------------------------------------------------------------------
 // CCommand extension class.
 //-----------------------------------------------------------------------------
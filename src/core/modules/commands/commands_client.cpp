@@ -32,6 +32,8 @@
 
 #include "boost/unordered_map.hpp"
 #include "commands_client.h"
+#include "commands_limiter.h"
+#include "commands_profiler.h"
 #include "commands.h"
 #include "edict.h"
 #include "convar.h"
@@ -107,6 +109,14 @@ void UnregisterClientCommandFilter(PyObject* pCallable)
 	s_ClientCommandFilters.UnregisterListener(pCallable);
 }
 
+//-----------------------------------------------------------------------------
+// Returns True if the given command is handled by the say command hooks.
+//-----------------------------------------------------------------------------
+static bool IsSayCommand(const char* szName)
+{
+	return V_stricmp(szName, "say") == 0 || V_stricmp(szName, "say_team") == 0;
+}
+
 //-----------------------------------------------------------------------------
 // Dispatches a client command.
 //-----------------------------------------------------------------------------
@@ -116,8 +126,16 @@ PLUGIN_RESULT DispatchClientCommand(edict_t* pEntity, const CCommand &command)
 	if (!IndexFromEdict(pEntity, iIndex))
 		return PLUGIN_CONTINUE;
 
+	// Drop the command before any Python code is executed, if the client
+	// exceeded its rate limit. say and say_team are charged when the say
+	// command itself is dispatched, so they are not counted twice.
 	bool block = false;
-	
+	if (g_CommandRateLimiter.HasLimits() && !IsSayCommand(command.Arg(0))
+		&& !g_CommandRateLimiter.Allow(iIndex, command.Arg(0), block))
+		return block ? PLUGIN_STOP : PLUGIN_CONTINUE;
+
+	double dStart = g_CommandProfiler.Start();
+
 	CListenerManager* mngr = &s_ClientCommandFilters;
 	FOREACH_CALLBACK_WITH_MNGR(
 		mngr,
@@ -130,7 +148,10 @@ PLUGIN_RESULT DispatchClientCommand(edict_t* pEntity, const CCommand &command)
 	)
 
 	if (block)
+	{
+		g_CommandProfiler.Stop(COMMAND_TYPE_CLIENT, command.Arg(0), dStart, true);
 		return PLUGIN_STOP;
+	}
 
 	block = false;
 	ClientCommandMap::iterator iter;
@@ -142,6 +163,8 @@ PLUGIN_RESULT DispatchClientCommand(edict_t* pEntity, const CCommand &command)
 		}
 	}
 
+	g_CommandProfiler.Stop(COMMAND_TYPE_CLIENT, command.Arg(0), dStart, block);
+
 	if (block)
 		return PLUGIN_STOP;
 
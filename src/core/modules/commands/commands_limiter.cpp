@@ -0,0 +1,213 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2015 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#include "tier0/platform.h"
+#include "commands_limiter.h"
+
+
+//-----------------------------------------------------------------------------
+// Global command rate limiter.
+//-----------------------------------------------------------------------------
+CCommandRateLimiter g_CommandRateLimiter;
+
+
+//-----------------------------------------------------------------------------
+// CCommandRateLimiter constructor.
+//-----------------------------------------------------------------------------
+CCommandRateLimiter::CCommandRateLimiter()
+{
+	memset(m_uiClientLimited, 0, sizeof(m_uiClientLimited));
+}
+
+//-----------------------------------------------------------------------------
+// CCommandRateLimiter destructor.
+//-----------------------------------------------------------------------------
+CCommandRateLimiter::~CCommandRateLimiter()
+{
+	ClearLimits();
+}
+
+//-----------------------------------------------------------------------------
+// Adds or updates the limit of a command.
+//-----------------------------------------------------------------------------
+void CCommandRateLimiter::SetLimit(const char* szName, float fRate, float fBurst, bool bBlock)
+{
+	if (fRate <= 0 || fBurst < 1)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Rate must be positive and burst must be at least 1.")
+
+	CommandLimit_t* pLimit;
+	CommandLimitMap::iterator iter;
+	if (find_manager_fast<CommandLimitMap, CommandLimitMap::iterator>(m_Limits, szName, iter))
+	{
+		pLimit = iter->second;
+	}
+	else
+	{
+		pLimit = new CommandLimit_t;
+		memset(pLimit, 0, sizeof(CommandLimit_t));
+		m_Limits.insert(std::make_pair(std::string(szName), pLimit));
+	}
+
+	pLimit->m_fRate = fRate;
+	pLimit->m_fBurst = fBurst;
+	pLimit->m_bBlock = bBlock;
+}
+
+//-----------------------------------------------------------------------------
+// Removes the limit of a command.
+//-----------------------------------------------------------------------------
+void CCommandRateLimiter::RemoveLimit(const char* szName)
+{
+	CommandLimitMap::iterator iter;
+	if (!find_manager_fast<CommandLimitMap, CommandLimitMap::iterator>(m_Limits, szName, iter))
+		BOOST_RAISE_EXCEPTION(PyExc_KeyError, "No limit for '%s'.", szName)
+
+	delete iter->second;
+	m_Limits.erase(iter);
+}
+
+//-----------------------------------------------------------------------------
+// Removes all limits.
+//-----------------------------------------------------------------------------
+void CCommandRateLimiter::ClearLimits()
+{
+	for (CommandLimitMap::iterator iter = m_Limits.begin(); iter != m_Limits.end(); ++iter)
+		delete iter->second;
+
+	m_Limits.clear();
+}
+
+bool CCommandRateLimiter::HasLimits()
+{
+	return !m_Limits.empty();
+}
+
+bool CCommandRateLimiter::HasLimit(const char* szName)
+{
+	CommandLimitMap::iterator iter;
+	return find_manager_fast<CommandLimitMap, CommandLimitMap::iterator>(m_Limits, szName, iter);
+}
+
+//-----------------------------------------------------------------------------
+// Takes a token from the client's bucket of the given command.
+//-----------------------------------------------------------------------------
+bool CCommandRateLimiter::Allow(int iIndex, const char* szName, bool& bBlock)
+{
+	bBlock = false;
+	if (iIndex <= 0 || iIndex > ABSOLUTE_PLAYER_LIMIT)
+		return true;
+
+	CommandLimitMap::iterator iter;
+	if (!find_manager_fast<CommandLimitMap, CommandLimitMap::iterator>(m_Limits, szName, iter))
+		return true;
+
+	CommandLimit_t* pLimit = iter->second;
+	double dNow = Plat_FloatTime();
+
+	// A fresh bucket is always full
+	if (pLimit->m_dLastUpdate[iIndex] == 0)
+	{
+		pLimit->m_fTokens[iIndex] = pLimit->m_fBurst;
+	}
+	else
+	{
+		float fTokens = pLimit->m_fTokens[iIndex] + (dNow - pLimit->m_dLastUpdate[iIndex]) * pLimit->m_fRate;
+		pLimit->m_fTokens[iIndex] = MIN(fTokens, pLimit->m_fBurst);
+	}
+
+	pLimit->m_dLastUpdate[iIndex] = dNow;
+	if (pLimit->m_fTokens[iIndex] >= 1)
+	{
+		pLimit->m_fTokens[iIndex] -= 1;
+		pLimit->m_uiAllowed++;
+		return true;
+	}
+
+	pLimit->m_uiLimited++;
+	m_uiClientLimited[iIndex]++;
+	bBlock = pLimit->m_bBlock;
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+// Resets the buckets and counter of a client (e.g. after a disconnect).
+//-----------------------------------------------------------------------------
+void CCommandRateLimiter::ResetClient(int iIndex)
+{
+	if (iIndex <= 0 || iIndex > ABSOLUTE_PLAYER_LIMIT)
+		return;
+
+	for (CommandLimitMap::iterator iter = m_Limits.begin(); iter != m_Limits.end(); ++iter)
+		iter->second->m_dLastUpdate[iIndex] = 0;
+
+	m_uiClientLimited[iIndex] = 0;
+}
+
+//-----------------------------------------------------------------------------
+// Resets all counters.
+//-----------------------------------------------------------------------------
+void CCommandRateLimiter::ResetStatistics()
+{
+	for (CommandLimitMap::iterator iter = m_Limits.begin(); iter != m_Limits.end(); ++iter)
+	{
+		iter->second->m_uiAllowed = 0;
+		iter->second->m_uiLimited = 0;
+	}
+
+	memset(m_uiClientLimited, 0, sizeof(m_uiClientLimited));
+}
+
+//-----------------------------------------------------------------------------
+// Returns (allowed, limited) for the given command.
+//-----------------------------------------------------------------------------
+tuple CCommandRateLimiter::GetCommandStatistics(const char* szName)
+{
+	CommandLimitMap::iterator iter;
+	if (!find_manager_fast<CommandLimitMap, CommandLimitMap::iterator>(m_Limits, szName, iter))
+		BOOST_RAISE_EXCEPTION(PyExc_KeyError, "No limit for '%s'.", szName)
+
+	return make_tuple(iter->second->m_uiAllowed, iter->second->m_uiLimited);
+}
+
+unsigned int CCommandRateLimiter::GetClientLimited(int iIndex)
+{
+	if (iIndex <= 0 || iIndex > ABSOLUTE_PLAYER_LIMIT)
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Index out of range.")
+
+	return m_uiClientLimited[iIndex];
+}
+
+list CCommandRateLimiter::GetLimitedCommands()
+{
+	list result;
+	for (CommandLimitMap::iterator iter = m_Limits.begin(); iter != m_Limits.end(); ++iter)
+		result.append(iter->first);
+
+	return result;
+}
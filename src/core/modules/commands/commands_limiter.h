@@ -0,0 +1,92 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2015 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+#ifndef _COMMANDS_LIMITER_H
+#define _COMMANDS_LIMITER_H
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#include "boost/unordered_map.hpp"
+#include "const.h"
+#include "commands.h"
+
+
+//-----------------------------------------------------------------------------
+// Token bucket of a single command for all clients.
+//-----------------------------------------------------------------------------
+struct CommandLimit_t
+{
+	float			m_fRate;
+	float			m_fBurst;
+	bool			m_bBlock;
+
+	unsigned int	m_uiAllowed;
+	unsigned int	m_uiLimited;
+
+	float			m_fTokens[ABSOLUTE_PLAYER_LIMIT + 1];
+	double			m_dLastUpdate[ABSOLUTE_PLAYER_LIMIT + 1];
+};
+
+typedef boost::unordered_map<std::string, CommandLimit_t*, StringHashNoCase, StringEqualNoCase> CommandLimitMap;
+
+
+//-----------------------------------------------------------------------------
+// Limits how often clients can use commands, before any Python code is
+// executed for them.
+//-----------------------------------------------------------------------------
+class CCommandRateLimiter
+{
+public:
+	CCommandRateLimiter();
+	~CCommandRateLimiter();
+
+	void SetLimit(const char* szName, float fRate, float fBurst, bool bBlock);
+	void RemoveLimit(const char* szName);
+	void ClearLimits();
+	bool HasLimits();
+	bool HasLimit(const char* szName);
+
+	// Returns false if the client exceeded the limit of the command. In that
+	// case bBlock is set to whether the command should be blocked completely
+	// or only skip Python.
+	bool Allow(int iIndex, const char* szName, bool& bBlock);
+
+	void ResetClient(int iIndex);
+	void ResetStatistics();
+
+	tuple GetCommandStatistics(const char* szName);
+	unsigned int GetClientLimited(int iIndex);
+	list GetLimitedCommands();
+
+private:
+	CommandLimitMap	m_Limits;
+	unsigned int	m_uiClientLimited[ABSOLUTE_PLAYER_LIMIT + 1];
+};
+
+extern CCommandRateLimiter g_CommandRateLimiter;
+
+
+#endif // _COMMANDS_LIMITER_H
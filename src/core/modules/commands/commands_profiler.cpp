@@ -0,0 +1,131 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2015 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#include <algorithm>
+#include <vector>
+#include "commands_profiler.h"
+
+
+//-----------------------------------------------------------------------------
+// Global command profiler.
+//-----------------------------------------------------------------------------
+CCommandProfiler g_CommandProfiler;
+
+
+//-----------------------------------------------------------------------------
+// Helpers.
+//-----------------------------------------------------------------------------
+struct HotCommand_t
+{
+	CommandType					m_Type;
+	const std::string*			m_pName;
+	const CommandStatistics_t*	m_pStatistics;
+
+	bool operator<(const HotCommand_t& other) const
+	{ return m_pStatistics->m_dPythonTime > other.m_pStatistics->m_dPythonTime; }
+};
+
+static tuple StatisticsToTuple(const CommandStatistics_t& stats)
+{
+	return make_tuple(stats.m_uiCalls, stats.m_uiBlocked, stats.m_dPythonTime, stats.m_dMaxPythonTime);
+}
+
+
+//-----------------------------------------------------------------------------
+// CCommandProfiler.
+//-----------------------------------------------------------------------------
+CCommandProfiler::CCommandProfiler()
+{
+	m_bEnabled = false;
+}
+
+void CCommandProfiler::Record(CommandType type, const char* szName, double dPythonTime, bool bBlocked)
+{
+	CommandStatisticsMap& statistics = m_Statistics[type];
+
+	CommandStatisticsMap::iterator iter;
+	if (!find_manager_fast<CommandStatisticsMap, CommandStatisticsMap::iterator>(statistics, szName, iter))
+	{
+		CommandStatistics_t empty;
+		memset(&empty, 0, sizeof(empty));
+		iter = statistics.insert(std::make_pair(std::string(szName), empty)).first;
+	}
+
+	CommandStatistics_t& stats = iter->second;
+	stats.m_uiCalls++;
+	stats.m_dPythonTime += dPythonTime;
+	stats.m_dMaxPythonTime = MAX(stats.m_dMaxPythonTime, dPythonTime);
+
+	if (bBlocked)
+		stats.m_uiBlocked++;
+}
+
+void CCommandProfiler::Reset()
+{
+	for (int i=0; i < COMMAND_TYPE_COUNT; ++i)
+		m_Statistics[i].clear();
+}
+
+dict CCommandProfiler::GetStatistics(CommandType type)
+{
+	if (type < 0 || type >= COMMAND_TYPE_COUNT)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Invalid command type: %i", type)
+
+	dict result;
+	CommandStatisticsMap& statistics = m_Statistics[type];
+	for (CommandStatisticsMap::iterator iter = statistics.begin(); iter != statistics.end(); ++iter)
+		result[iter->first] = StatisticsToTuple(iter->second);
+
+	return result;
+}
+
+list CCommandProfiler::GetHotCommands(int iCount)
+{
+	std::vector<HotCommand_t> commands;
+	for (int i=0; i < COMMAND_TYPE_COUNT; ++i)
+	{
+		CommandStatisticsMap& statistics = m_Statistics[i];
+		for (CommandStatisticsMap::iterator iter = statistics.begin(); iter != statistics.end(); ++iter)
+		{
+			HotCommand_t command = {(CommandType) i, &iter->first, &iter->second};
+			commands.push_back(command);
+		}
+	}
+
+	std::sort(commands.begin(), commands.end());
+
+	list result;
+	for (int i=0; i < (int) commands.size() && (iCount < 0 || i < iCount); ++i)
+	{
+		HotCommand_t& command = commands[i];
+		result.append(make_tuple(command.m_Type, *command.m_pName) + StatisticsToTuple(*command.m_pStatistics));
+	}
+
+	return result;
+}
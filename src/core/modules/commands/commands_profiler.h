@@ -0,0 +1,100 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2015 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+#ifndef _COMMANDS_PROFILER_H
+#define _COMMANDS_PROFILER_H
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#include "boost/unordered_map.hpp"
+#include "tier0/platform.h"
+#include "commands.h"
+
+
+//-----------------------------------------------------------------------------
+// Command types.
+//-----------------------------------------------------------------------------
+enum CommandType
+{
+	COMMAND_TYPE_SERVER = 0,
+	COMMAND_TYPE_CLIENT,
+	COMMAND_TYPE_SAY,
+
+	COMMAND_TYPE_COUNT
+};
+
+
+//-----------------------------------------------------------------------------
+// Statistics of a single command.
+//-----------------------------------------------------------------------------
+struct CommandStatistics_t
+{
+	unsigned int	m_uiCalls;
+	unsigned int	m_uiBlocked;
+	double			m_dPythonTime;
+	double			m_dMaxPythonTime;
+};
+
+typedef boost::unordered_map<std::string, CommandStatistics_t, StringHashNoCase, StringEqualNoCase> CommandStatisticsMap;
+
+
+//-----------------------------------------------------------------------------
+// Records how often commands are used and how much time is spent in their
+// Python callbacks. When disabled, dispatching a command only costs a check
+// of m_bEnabled.
+//-----------------------------------------------------------------------------
+class CCommandProfiler
+{
+public:
+	CCommandProfiler();
+
+	// Returns the current time if the profiler is enabled, otherwise 0
+	inline double Start()
+	{ return m_bEnabled ? Plat_FloatTime() : 0; }
+
+	inline void Stop(CommandType type, const char* szName, double dStart, bool bBlocked)
+	{
+		if (dStart)
+			Record(type, szName, Plat_FloatTime() - dStart, bBlocked);
+	}
+
+	void Record(CommandType type, const char* szName, double dPythonTime, bool bBlocked);
+	void Reset();
+
+	dict GetStatistics(CommandType type);
+	list GetHotCommands(int iCount);
+
+public:
+	bool m_bEnabled;
+
+private:
+	CommandStatisticsMap m_Statistics[COMMAND_TYPE_COUNT];
+};
+
+extern CCommandProfiler g_CommandProfiler;
+
+
+#endif // _COMMANDS_PROFILER_H
@@ -39,15 +39,17 @@
 #include "sp_main.h"
 #include "modules/listeners/listeners_manager.h"
 #include "convar.h"
+#include "tier1/characterset.h"
 
 #include "commands_say.h"
+#include "commands_limiter.h"
+#include "commands_profiler.h"
 #include "commands.h"
 
 
 //-----------------------------------------------------------------------------
 // Global say command mapping.
 //-----------------------------------------------------------------------------
-typedef boost::unordered_map<std::string, CSayCommandManager*> SayCommandMap;
 SayCommandMap g_SayCommandMap;
 
 //-----------------------------------------------------------------------------
@@ -101,7 +103,7 @@ CSayCommandManager* GetSayCommand(const char* szName)
 {
 	CSayCommandManager* manager = NULL;
 	SayCommandMap::iterator iter;
-	if (!find_manager<SayCommandMap, SayCommandMap::iterator>(g_SayCommandMap, szName, iter))
+	if (!find_manager_fast<SayCommandMap, SayCommandMap::iterator>(g_SayCommandMap, szName, iter))
 	{
 		manager = new CSayCommandManager(szName);
 		g_SayCommandMap.insert(std::make_pair(manager->m_Name, manager));
@@ -119,7 +121,7 @@ CSayCommandManager* GetSayCommand(const char* szName)
 void RemoveCSayCommandManager(const char* szName)
 {
 	SayCommandMap::iterator iter;
-	if (find_manager<SayCommandMap, SayCommandMap::iterator>(g_SayCommandMap, szName, iter))
+	if (find_manager_fast<SayCommandMap, SayCommandMap::iterator>(g_SayCommandMap, szName, iter))
 	{
 		delete iter->second;
 		g_SayCommandMap.erase(iter);
@@ -225,27 +227,51 @@ void SayConCommand::Dispatch( const CCommand& command )
 	// Get whether the command was say or say_team
 	bool bTeamOnly = strcmp(command.Arg(0), "say_team") == 0;
 
-	// Create a new CCommand object that does not contain the first argument
-	// (say or say_team) and is properly splitted
-	CCommand stripped_command = CCommand();
-	char szTempCommand[512];
-	strcpy(szTempCommand, command.ArgS());
-	char* szCommand = szTempCommand;
+	// The text without the first argument (say or say_team)
+	CSayText text(command.ArgS());
 
-	// Remove quotes (if existant), so the arguments are not recognized as a
-	// single argument.
-	int iLastCharPos = strlen(szCommand) - 1;
-	if (szCommand[0] == '"' && szCommand[iLastCharPos] == '"') {
-		szCommand[iLastCharPos] = '\0';
-		szCommand++;
+	// Drop the message before any Python code is executed, if the client
+	// exceeded the rate limit of say/say_team or of the say command
+	if (g_CommandRateLimiter.HasLimits())
+	{
+		bool bBlock;
+		char szName[COMMAND_MAX_LENGTH];
+		if (!g_CommandRateLimiter.Allow(iIndex, command.Arg(0), bBlock) ||
+			(text.GetFirstToken(szName, sizeof(szName)) && !g_CommandRateLimiter.Allow(iIndex, szName, bBlock)))
+		{
+			if( !bBlock && m_pOldCommand )
+				m_pOldCommand->Dispatch(command);
+
+			return;
+		}
+	}
+
+	// Don't enter Python at all if neither a say filter nor a say command is
+	// interested in this message
+	if (!s_SayFilters.GetCount())
+	{
+		char szName[COMMAND_MAX_LENGTH];
+		SayCommandMap::iterator iter;
+		if (g_SayCommandMap.empty() || !text.GetFirstToken(szName, sizeof(szName)) ||
+			!find_manager_fast<SayCommandMap, SayCommandMap::iterator>(g_SayCommandMap, szName, iter))
+		{
+			if( m_pOldCommand )
+				m_pOldCommand->Dispatch(command);
+
+			return;
+		}
 	}
 
-	if (!stripped_command.Tokenize(szCommand)) {
+	// Create a new CCommand object that does not contain the first argument
+	// (say or say_team) and is properly splitted
+	CCommand stripped_command = CCommand();
+	if (!text.Tokenize(stripped_command)) {
 		PythonLog(0, "Failed to tokenize '%s'.", command.GetCommandString());
 		return;
 	}
 
 	bool block = false;
+	double dStart = g_CommandProfiler.Start();
 
 	// Loop through all registered Say Filter callbacks
 	CListenerManager* mngr = &s_SayFilters;
@@ -260,16 +286,28 @@ void SayConCommand::Dispatch( const CCommand& command )
 	)
 
 	if (block)
+	{
+		g_CommandProfiler.Stop(COMMAND_TYPE_SAY, command.Arg(0), dStart, true);
 		return;
+	}
 
+	// Look up the command again, because the filters might have changed the
+	// registered commands
 	block = false;
 	SayCommandMap::iterator iter;
-	if (find_manager<SayCommandMap, SayCommandMap::iterator>(g_SayCommandMap, stripped_command[0], iter))
+	if (find_manager_fast<SayCommandMap, SayCommandMap::iterator>(g_SayCommandMap, stripped_command[0], iter))
 	{
 		if(iter->second->Dispatch(stripped_command, iIndex, bTeamOnly) == BLOCK)
 		{
 			block = true;
 		}
+
+		g_CommandProfiler.Stop(COMMAND_TYPE_SAY, stripped_command[0], dStart, block);
+	}
+	else
+	{
+		// Only the say filters have been called
+		g_CommandProfiler.Stop(COMMAND_TYPE_SAY, command.Arg(0), dStart, block);
 	}
 
 	if (block)
@@ -283,6 +321,87 @@ void SayConCommand::Dispatch( const CCommand& command )
 	}
 }
 
+//-----------------------------------------------------------------------------
+// CSayText constructor.
+//-----------------------------------------------------------------------------
+CSayText::CSayText(const char* szArgS)
+{
+	m_pText = szArgS;
+	m_iLength = strlen(szArgS);
+
+	// Remove quotes (if existant), so the arguments are not recognized as a
+	// single argument.
+	if (m_iLength > 0 && m_pText[0] == '"' && m_pText[m_iLength - 1] == '"') {
+		m_pText++;
+		m_iLength = MAX(m_iLength - 2, 0);
+	}
+
+	// Find the first token the same way CCommand::Tokenize() does
+	const char* pCurrent = m_pText;
+	const char* pEnd = m_pText + m_iLength;
+	m_pFirstToken = pCurrent;
+	m_iFirstTokenLength = 0;
+
+	while (pCurrent < pEnd && isspace((unsigned char) *pCurrent))
+		pCurrent++;
+
+	// Empty or a C++ comment
+	if (pCurrent == pEnd || (pEnd - pCurrent >= 2 && pCurrent[0] == '/' && pCurrent[1] == '/'))
+		return;
+
+	// Quoted string
+	if (*pCurrent == '"')
+	{
+		m_pFirstToken = ++pCurrent;
+		while (pCurrent < pEnd && *pCurrent != '"')
+			pCurrent++;
+
+		m_iFirstTokenLength = pCurrent - m_pFirstToken;
+		return;
+	}
+
+	// Single break character
+	characterset_t* pBreakSet = CCommand::DefaultBreakSet();
+	m_pFirstToken = pCurrent;
+	if (IN_CHARACTERSET(*pBreakSet, *pCurrent))
+	{
+		m_iFirstTokenLength = 1;
+		return;
+	}
+
+	// Regular word
+	while (pCurrent < pEnd && (unsigned char) *pCurrent > ' ' && *pCurrent != '"' && !IN_CHARACTERSET(*pBreakSet, *pCurrent))
+		pCurrent++;
+
+	m_iFirstTokenLength = pCurrent - m_pFirstToken;
+}
+
+//-----------------------------------------------------------------------------
+// Copies the first token into the given buffer.
+//-----------------------------------------------------------------------------
+bool CSayText::GetFirstToken(char* szBuffer, int iSize) const
+{
+	if (m_iFirstTokenLength >= iSize)
+		return false;
+
+	V_strncpy(szBuffer, m_pFirstToken, m_iFirstTokenLength + 1);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Tokenizes the text into the given command.
+//-----------------------------------------------------------------------------
+bool CSayText::Tokenize(CCommand& command) const
+{
+	// CCommand can't handle more than this anyway
+	if (m_iLength >= COMMAND_MAX_LENGTH)
+		return false;
+
+	char szText[COMMAND_MAX_LENGTH];
+	V_strncpy(szText, m_pText, m_iLength + 1);
+	return command.Tokenize(szText);
+}
+
 //-----------------------------------------------------------------------------
 // CSayCommandManager constructor.
 //-----------------------------------------------------------------------------
@@ -29,6 +29,7 @@
 //-----------------------------------------------------------------------------
 // Includes
 //-----------------------------------------------------------------------------
+#include "boost/unordered_map.hpp"
 #include "utilities/sp_util.h"
 #include "commands.h"
 #include "edict.h"
@@ -37,6 +38,33 @@
 #include "modules/listeners/listeners_manager.h"
 
 
+//-----------------------------------------------------------------------------
+// Say command mapping.
+//-----------------------------------------------------------------------------
+class CSayCommandManager;
+typedef boost::unordered_map<std::string, CSayCommandManager*, StringHashNoCase, StringEqualNoCase> SayCommandMap;
+
+
+//-----------------------------------------------------------------------------
+// A view over the text of a say command. It strips the surrounding quotes and
+// finds the first token (the command name) without copying the text.
+//-----------------------------------------------------------------------------
+class CSayText
+{
+public:
+	CSayText(const char* szArgS);
+
+	bool GetFirstToken(char* szBuffer, int iSize) const;
+	bool Tokenize(CCommand& command) const;
+
+public:
+	const char* m_pText;
+	int			m_iLength;
+	const char* m_pFirstToken;
+	int			m_iFirstTokenLength;
+};
+
+
 //-----------------------------------------------------------------------------
 // Say ConCommand instance class.
 //-----------------------------------------------------------------------------
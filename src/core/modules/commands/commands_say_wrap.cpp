@@ -45,7 +45,7 @@ extern CSayCommandManager* GetSayCommand(const char* szName);
 extern void RegisterSayFilter(PyObject* pCallable);
 extern void UnregisterSayFilter(PyObject* pCallable);
 
-extern boost::unordered_map<std::string, CSayCommandManager*> g_SayCommandMap;
+extern SayCommandMap g_SayCommandMap;
 COMMAND_GENERATOR(SayCommandGenerator, g_SayCommandMap)
 
 
@@ -38,6 +38,7 @@
 
 #include "commands.h"
 #include "commands_server.h"
+#include "commands_profiler.h"
 
 //-----------------------------------------------------------------------------
 // Externs.
@@ -213,6 +214,7 @@ void CServerCommandManager::RemoveCallback( PyObject* pCallable, HookType_t type
 void CServerCommandManager::Dispatch( const CCommand& command )
 {
 	bool block = false;
+	double dStart = g_CommandProfiler.Start();
 
 	// Pre hook callbacks
 	FOREACH_CALLBACK_WITH_MNGR(
@@ -226,7 +228,13 @@ void CServerCommandManager::Dispatch( const CCommand& command )
 	)
 
 	if (block)
+	{
+		g_CommandProfiler.Stop(COMMAND_TYPE_SERVER, m_Name, dStart, true);
 		return;
+	}
+
+	// Don't count the time of the original command
+	double dPythonTime = dStart ? Plat_FloatTime() - dStart : 0;
 
 	// Was the command previously registered?
 	if(m_pOldCommand)
@@ -234,8 +242,13 @@ void CServerCommandManager::Dispatch( const CCommand& command )
 		m_pOldCommand->Dispatch(command);
 	}
 
+	double dPostStart = dStart ? Plat_FloatTime() : 0;
+
 	// Post hook callbacks
 	CALL_LISTENERS_WITH_MNGR(m_vecCallables[HOOKTYPE_POST], boost::ref(command))
+
+	if (dStart)
+		g_CommandProfiler.Record(COMMAND_TYPE_SERVER, m_Name, dPythonTime + Plat_FloatTime() - dPostStart, false);
 }
 
 //-----------------------------------------------------------------------------
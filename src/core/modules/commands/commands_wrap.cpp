@@ -36,6 +36,8 @@
 #include "commands_say.h"
 #include "commands.h"
 #include "commands_server.h"
+#include "commands_limiter.h"
+#include "commands_profiler.h"
 #include "sp_main.h"
 
 
@@ -84,6 +86,9 @@ void export_command(scope);
 void export_command_return(scope);
 void export_concommandbase(scope);
 void export_concommand(scope);
+void export_command_rate_limiter(scope);
+void export_command_type(scope);
+void export_command_profiler(scope);
 
 
 //-----------------------------------------------------------------------------
@@ -95,6 +100,9 @@ DECLARE_SP_MODULE(_commands)
 	export_command_return(_commands);
 	export_concommandbase(_commands);
 	export_concommand(_commands);
+	export_command_rate_limiter(_commands);
+	export_command_type(_commands);
+	export_command_profiler(_commands);
 }
 
 
@@ -241,3 +249,151 @@ void export_concommand(scope _commands)
 
 	_ConCommand ADD_MEM_TOOLS(ConCommand);
 }
+
+
+
+//-----------------------------------------------------------------------------
+// Expose CCommandRateLimiter.
+//-----------------------------------------------------------------------------
+void export_command_rate_limiter(scope _commands)
+{
+	class_<CCommandRateLimiter, boost::noncopyable> CommandRateLimiter("CommandRateLimiter", no_init);
+
+	CommandRateLimiter.def(
+		"set_limit",
+		&CCommandRateLimiter::SetLimit,
+		"Limit how often each client can use a client or say command.\n\n"
+		":param str name:\n"
+		"    Name of the command (case insensitive). For say commands this is the first\n"
+		"    word of the message (e.g. ``!rtv``) or ``say``/``say_team`` for all messages.\n"
+		":param float rate:\n"
+		"    Number of uses per second that are refilled into the client's bucket.\n"
+		":param float burst:\n"
+		"    Maximum number of uses a client can save up.\n"
+		":param bool block:\n"
+		"    If True, commands over the limit are blocked completely. Otherwise they are\n"
+		"    only hidden from Source.Python and still passed to the game.",
+		("name", "rate", "burst", arg("block")=true)
+	);
+
+	CommandRateLimiter.def(
+		"remove_limit",
+		&CCommandRateLimiter::RemoveLimit,
+		"Remove the limit of a command.\n\n"
+		":raise KeyError:\n"
+		"    Raised if the command has no limit.",
+		args("name")
+	);
+
+	CommandRateLimiter.def(
+		"clear",
+		&CCommandRateLimiter::ClearLimits,
+		"Remove all limits."
+	);
+
+	CommandRateLimiter.def(
+		"__contains__",
+		&CCommandRateLimiter::HasLimit,
+		"Return True if the given command has a limit.",
+		args("name")
+	);
+
+	CommandRateLimiter.add_property(
+		"commands",
+		&CCommandRateLimiter::GetLimitedCommands,
+		"Return the names of all commands that have a limit.\n\n"
+		":rtype: list"
+	);
+
+	CommandRateLimiter.def(
+		"get_command_statistics",
+		&CCommandRateLimiter::GetCommandStatistics,
+		"Return how often a command has been allowed and how often it has been limited.\n\n"
+		":rtype: tuple",
+		args("name")
+	);
+
+	CommandRateLimiter.def(
+		"get_client_limited",
+		&CCommandRateLimiter::GetClientLimited,
+		"Return how many commands of the given client have been limited.\n\n"
+		":rtype: int",
+		args("index")
+	);
+
+	CommandRateLimiter.def(
+		"reset_client",
+		&CCommandRateLimiter::ResetClient,
+		"Refill all buckets and reset the counter of the given client.",
+		args("index")
+	);
+
+	CommandRateLimiter.def(
+		"reset_statistics",
+		&CCommandRateLimiter::ResetStatistics,
+		"Reset all counters."
+	);
+
+	_commands.attr("command_rate_limiter") = object(ptr(&g_CommandRateLimiter));
+}
+
+
+//-----------------------------------------------------------------------------
+// Expose CommandType.
+//-----------------------------------------------------------------------------
+void export_command_type(scope _commands)
+{
+	enum_<CommandType>("CommandType")
+		.value("SERVER", COMMAND_TYPE_SERVER)
+		.value("CLIENT", COMMAND_TYPE_CLIENT)
+		.value("SAY", COMMAND_TYPE_SAY)
+	;
+}
+
+
+//-----------------------------------------------------------------------------
+// Expose CCommandProfiler.
+//-----------------------------------------------------------------------------
+void export_command_profiler(scope _commands)
+{
+	class_<CCommandProfiler, boost::noncopyable> CommandProfiler("CommandProfiler", no_init);
+
+	CommandProfiler.def_readwrite(
+		"enabled",
+		&CCommandProfiler::m_bEnabled,
+		"Get/set whether commands are profiled.\n\n"
+		":rtype: bool"
+	);
+
+	CommandProfiler.def(
+		"get_statistics",
+		&CCommandProfiler::GetStatistics,
+		"Return the statistics of all commands of the given type.\n\n"
+		"Each value is a tuple of (calls, blocked, python_time, max_python_time).\n"
+		"Times are in seconds. Say messages that did not match a say command are\n"
+		"recorded as ``say`` or ``say_team``.\n\n"
+		":param CommandType type:\n"
+		"    The type of the commands.\n"
+		":rtype: dict",
+		args("type")
+	);
+
+	CommandProfiler.def(
+		"get_hot_commands",
+		&CCommandProfiler::GetHotCommands,
+		"Return the commands that spent the most time in Python.\n\n"
+		"Each item is a tuple of (type, name, calls, blocked, python_time, max_python_time).\n\n"
+		":param int count:\n"
+		"    Maximum number of commands to return. -1 returns all of them.\n"
+		":rtype: list",
+		(arg("count")=-1)
+	);
+
+	CommandProfiler.def(
+		"reset",
+		&CCommandProfiler::Reset,
+		"Remove all recorded statistics."
+	);
+
+	_commands.attr("command_profiler") = object(ptr(&g_CommandProfiler));
+}
\ No newline at end of file
@@ -0,0 +1,388 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2015 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+// Source.Python
+#include "effects_base.h"
+#include "modules/colors/colors.h"
+#include "modules/filters/filters_recipients.h"
+
+// SDK
+#include "mathlib/vector.h"
+
+// Boost.Python
+#include "boost/python/stl_iterator.hpp"
+
+
+//-----------------------------------------------------------------------------
+// Helper functions.
+//-----------------------------------------------------------------------------
+static int GetIndexValue(object value)
+{
+	// Players and entities expose their index
+	if (PyObject_HasAttrString(value.ptr(), "index"))
+		return extract<int>(value.attr("index"));
+
+	return extract<int>(value);
+}
+
+static int GetFieldIndexValue(const TempEntityField_t& field, object value)
+{
+	// Decal, Model, Entity and Player aliases only accept their own class
+	if (!field.m_oClass.is_none() && !PyObject_IsInstance(value.ptr(), field.m_oClass.ptr()))
+	{
+		std::string repr = extract<std::string>(str(value));
+		std::string class_name = extract<std::string>(field.m_oClass.attr("__name__"));
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "\"%s\" is not a valid %s instance.", repr.c_str(), class_name.c_str());
+	}
+
+	return extract<int>(value.attr("index"));
+}
+
+
+//-----------------------------------------------------------------------------
+// CTempEntityLayout constructor/destructor.
+//-----------------------------------------------------------------------------
+CTempEntityLayout::CTempEntityLayout(unsigned int uiSize)
+{
+	m_uiSize = uiSize;
+	m_pBuffer = NULL;
+	m_bBufferInUse = false;
+}
+
+CTempEntityLayout::~CTempEntityLayout()
+{
+	if (m_pBuffer)
+		UTIL_Dealloc(m_pBuffer);
+}
+
+
+//-----------------------------------------------------------------------------
+// Adds a field to the layout.
+//-----------------------------------------------------------------------------
+void CTempEntityLayout::CheckOffset(int iOffset, unsigned int uiSize)
+{
+	if (iOffset < 0 || (unsigned int) iOffset + uiSize > m_uiSize)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Offset %d is out of range (size: %u).", iOffset, m_uiSize);
+}
+
+void CTempEntityLayout::AddField(const char* szAlias, int iOffset, TempEntityFieldType_t nType, object cls)
+{
+	switch (nType)
+	{
+		case TE_FIELD_INT:
+		case TE_FIELD_INDEX:
+			CheckOffset(iOffset, sizeof(int));
+			break;
+
+		case TE_FIELD_FLOAT:
+			CheckOffset(iOffset, sizeof(float));
+			break;
+
+		case TE_FIELD_VECTOR:
+			CheckOffset(iOffset, sizeof(Vector));
+			break;
+
+		default:
+			BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Use add_color() to add color fields.");
+	}
+
+	if (!cls.is_none() && nType != TE_FIELD_INDEX)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "A class can only be given for index fields.");
+
+	TempEntityField_t field;
+	field.m_nType = nType;
+	field.m_iOffsets[0] = iOffset;
+	field.m_iOffsets[1] = field.m_iOffsets[2] = field.m_iOffsets[3] = -1;
+	field.m_oClass = cls;
+	m_Fields[szAlias] = field;
+}
+
+void CTempEntityLayout::AddColor(const char* szAlias, object offsets)
+{
+	TempEntityField_t field;
+	field.m_nType = TE_FIELD_COLOR;
+
+	int iCount = len(offsets);
+	if (iCount < 3 || iCount > 4)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Expected 3 or 4 offsets, got %d.", iCount);
+
+	for (int i=0; i < 4; ++i)
+	{
+		// The alpha offset is optional and stored as -1 if missing
+		if (i >= iCount)
+		{
+			field.m_iOffsets[i] = -1;
+			continue;
+		}
+
+		field.m_iOffsets[i] = extract<int>(offsets[i]);
+		CheckOffset(field.m_iOffsets[i], sizeof(int));
+	}
+
+	m_Fields[szAlias] = field;
+}
+
+
+//-----------------------------------------------------------------------------
+// Layout information.
+//-----------------------------------------------------------------------------
+bool CTempEntityLayout::HasField(const char* szAlias)
+{
+	return m_Fields.find(szAlias) != m_Fields.end();
+}
+
+int CTempEntityLayout::GetFieldCount()
+{
+	return (int) m_Fields.size();
+}
+
+unsigned int CTempEntityLayout::GetSize()
+{
+	return m_uiSize;
+}
+
+
+//-----------------------------------------------------------------------------
+// Writes fields to an existing temp entity.
+//-----------------------------------------------------------------------------
+void CTempEntityLayout::SetField(CBaseTempEntity* pTempEntity, const char* szAlias, object value)
+{
+	FieldMap::const_iterator it = m_Fields.find(szAlias);
+	if (it == m_Fields.end())
+		BOOST_RAISE_EXCEPTION(PyExc_NameError, "\"%s\" is not a field of this layout.", szAlias);
+
+	WriteField((void *) pTempEntity, it->second, value);
+}
+
+void CTempEntityLayout::SetFields(CBaseTempEntity* pTempEntity, dict fields)
+{
+	WriteFields((void *) pTempEntity, fields);
+}
+
+void CTempEntityLayout::WriteFields(void* pBase, dict fields)
+{
+	object items = fields.items();
+	stl_input_iterator<tuple> it(items), end;
+	for (; it != end; ++it)
+	{
+		tuple item = *it;
+		const char* szAlias = extract<const char*>(item[0]);
+
+		FieldMap::const_iterator field = m_Fields.find(szAlias);
+		if (field == m_Fields.end())
+			BOOST_RAISE_EXCEPTION(PyExc_NameError, "\"%s\" is not a field of this layout.", szAlias);
+
+		WriteField(pBase, field->second, item[1]);
+	}
+}
+
+void CTempEntityLayout::WriteField(void* pBase, const TempEntityField_t& field, object value)
+{
+	unsigned char* pData = (unsigned char *) pBase;
+
+	switch (field.m_nType)
+	{
+		case TE_FIELD_INT:
+			*(int *) (pData + field.m_iOffsets[0]) = extract<int>(value);
+			break;
+
+		case TE_FIELD_FLOAT:
+			*(float *) (pData + field.m_iOffsets[0]) = extract<float>(value);
+			break;
+
+		case TE_FIELD_VECTOR:
+			*(Vector *) (pData + field.m_iOffsets[0]) = extract<Vector&>(value);
+			break;
+
+		case TE_FIELD_INDEX:
+			*(int *) (pData + field.m_iOffsets[0]) = GetFieldIndexValue(field, value);
+			break;
+
+		case TE_FIELD_COLOR:
+		{
+			int iValues[4];
+			extract<Color*> color(value);
+			if (color.check())
+			{
+				Color* pColor = color();
+				iValues[0] = pColor->r();
+				iValues[1] = pColor->g();
+				iValues[2] = pColor->b();
+				iValues[3] = pColor->a();
+			}
+			else
+			{
+				for (int i=0; i < 4; ++i)
+				{
+					if (field.m_iOffsets[i] != -1)
+						iValues[i] = extract<int>(value[i]);
+				}
+			}
+
+			for (int i=0; i < 4; ++i)
+			{
+				if (field.m_iOffsets[i] != -1)
+					*(int *) (pData + field.m_iOffsets[i]) = iValues[i];
+			}
+			break;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+// Copies the template, writes the given fields and dispatches the copy.
+//-----------------------------------------------------------------------------
+void CTempEntityLayout::CreateAndSend(CBaseTempEntity* pTemplate, IRecipientFilter& filter, float flDelay, dict fields)
+{
+	// A hook on Create() might dispatch another effect of the same template,
+	// so only reuse the scratch buffer if nobody else is using it.
+	bool bUseScratch = !m_bBufferInUse;
+	void* pBuffer = NULL;
+	if (bUseScratch)
+	{
+		if (!m_pBuffer)
+			m_pBuffer = UTIL_Alloc(m_uiSize);
+
+		pBuffer = m_pBuffer;
+	}
+	else
+	{
+		pBuffer = UTIL_Alloc(m_uiSize);
+	}
+
+	if (!pBuffer)
+		BOOST_RAISE_EXCEPTION(PyExc_MemoryError, "Unable to allocate memory.");
+
+	if (bUseScratch)
+		m_bBufferInUse = true;
+
+	try
+	{
+		CopyTemplate(pBuffer, pTemplate, fields);
+		((CBaseTempEntity *) pBuffer)->Create(filter, flDelay);
+	}
+	catch (...)
+	{
+		if (bUseScratch)
+			m_bBufferInUse = false;
+		else
+			UTIL_Dealloc(pBuffer);
+
+		throw;
+	}
+
+	if (bUseScratch)
+		m_bBufferInUse = false;
+	else
+		UTIL_Dealloc(pBuffer);
+}
+
+
+void CTempEntityLayout::CopyTemplate(void* pDest, CBaseTempEntity* pTemplate, dict fields)
+{
+	memcpy(pDest, (void *) pTemplate, m_uiSize);
+	WriteFields(pDest, fields);
+}
+
+
+//-----------------------------------------------------------------------------
+// Helper functions shared with the temp entity queue.
+//-----------------------------------------------------------------------------
+object GetTempEntityTemplate(object temp_entity_template)
+{
+	if (PyUnicode_Check(temp_entity_template.ptr()))
+		return import("effects.templates").attr("temp_entity_templates")[temp_entity_template];
+
+	return temp_entity_template;
+}
+
+void AddTempEntityRecipients(MRecipientFilter& filter, object recipients)
+{
+	extract<IRecipientFilter*> other(recipients);
+	if (other.check())
+	{
+		filter.MergeRecipients(other());
+		return;
+	}
+
+	extract<int> index(recipients);
+	if (index.check())
+	{
+		filter.AddRecipient(index());
+		return;
+	}
+
+	if (PyObject_HasAttrString(recipients.ptr(), "index"))
+	{
+		filter.AddRecipient(extract<int>(recipients.attr("index")));
+		return;
+	}
+
+	stl_input_iterator<object> it(recipients), end;
+	for (; it != end; ++it)
+		filter.AddRecipient(GetIndexValue(*it));
+}
+
+
+//-----------------------------------------------------------------------------
+// create_and_send(template, recipients, delay=0.0, **fields)
+//-----------------------------------------------------------------------------
+object TempEntity_CreateAndSend(tuple args, dict kwargs)
+{
+	int iArgCount = len(args);
+	if (iArgCount < 2 || iArgCount > 3)
+		BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Expected 2 or 3 positional arguments, got %d.", iArgCount);
+
+	object temp_entity_template = GetTempEntityTemplate(args[0]);
+	CBaseTempEntity* pTemplate = extract<CBaseTempEntity*>(temp_entity_template);
+	CTempEntityLayout* pLayout = extract<CTempEntityLayout*>(temp_entity_template.attr("layout"));
+
+	float flDelay = 0;
+	if (iArgCount == 3)
+		flDelay = extract<float>(args[2]);
+	else if (kwargs.has_key("delay"))
+		flDelay = extract<float>(kwargs.attr("pop")("delay"));
+
+	object recipients = args[1];
+	extract<IRecipientFilter&> filter(recipients);
+	if (filter.check())
+	{
+		pLayout->CreateAndSend(pTemplate, filter(), flDelay, kwargs);
+	}
+	else
+	{
+		MRecipientFilter temp_filter;
+		AddTempEntityRecipients(temp_filter, recipients);
+		pLayout->CreateAndSend(pTemplate, temp_filter, flDelay, kwargs);
+	}
+
+	return object();
+}
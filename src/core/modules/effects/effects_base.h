@@ -34,6 +34,10 @@
 #include "utilities/sp_util.h"
 #include "game/server/basetempentity.h"
 #include "modules/memory/memory_alloc.h"
+#include "irecipientfilter.h"
+
+// Boost
+#include "boost/unordered_map.hpp"
 
 
 //-----------------------------------------------------------------------------
@@ -64,4 +68,89 @@ public:
 };
 
 
+//-----------------------------------------------------------------------------
+// Types of the fields a CTempEntityLayout is able to write.
+//-----------------------------------------------------------------------------
+enum TempEntityFieldType_t
+{
+	TE_FIELD_INT,
+	TE_FIELD_FLOAT,
+	TE_FIELD_VECTOR,
+	TE_FIELD_INDEX,
+	TE_FIELD_COLOR
+};
+
+
+//-----------------------------------------------------------------------------
+// A single compiled alias of a temp entity template.
+//-----------------------------------------------------------------------------
+struct TempEntityField_t
+{
+	TempEntityFieldType_t m_nType;
+
+	// Only TE_FIELD_COLOR uses all of them. Unused offsets are -1.
+	int m_iOffsets[4];
+
+	// Class the values of a TE_FIELD_INDEX field must be an instance of
+	object m_oClass;
+};
+
+
+//-----------------------------------------------------------------------------
+// Alias -> (offset, type) layout compiled from a temp entity template.
+//-----------------------------------------------------------------------------
+class CTempEntityLayout
+{
+public:
+	CTempEntityLayout(unsigned int uiSize);
+	~CTempEntityLayout();
+
+	void AddField(const char* szAlias, int iOffset, TempEntityFieldType_t nType, object cls);
+	void AddColor(const char* szAlias, object offsets);
+
+	bool HasField(const char* szAlias);
+	int GetFieldCount();
+	unsigned int GetSize();
+
+	void SetField(CBaseTempEntity* pTempEntity, const char* szAlias, object value);
+	void SetFields(CBaseTempEntity* pTempEntity, dict fields);
+
+	void CreateAndSend(CBaseTempEntity* pTemplate, IRecipientFilter& filter, float flDelay, dict fields);
+	void CopyTemplate(void* pDest, CBaseTempEntity* pTemplate, dict fields);
+
+private:
+	void CheckOffset(int iOffset, unsigned int uiSize);
+	void WriteFields(void* pBase, dict fields);
+	void WriteField(void* pBase, const TempEntityField_t& field, object value);
+
+private:
+	typedef boost::unordered_map<std::string, TempEntityField_t> FieldMap;
+
+	FieldMap		m_Fields;
+	unsigned int	m_uiSize;
+
+	// Scratch copy of the template, reused by CreateAndSend().
+	void*			m_pBuffer;
+	bool			m_bBufferInUse;
+};
+
+
+//-----------------------------------------------------------------------------
+// Helper functions shared with the temp entity queue.
+//-----------------------------------------------------------------------------
+class MRecipientFilter;
+
+// Returns the TempEntityTemplate matching the given template or name.
+object GetTempEntityTemplate(object temp_entity_template);
+
+// Adds a recipient filter, a player, an index or an iterable of them.
+void AddTempEntityRecipients(MRecipientFilter& filter, object recipients);
+
+
+//-----------------------------------------------------------------------------
+// create_and_send(template, recipients, delay=0.0, **fields)
+//-----------------------------------------------------------------------------
+object TempEntity_CreateAndSend(tuple args, dict kwargs);
+
+
 #endif // _EFFECTS_BASE_H
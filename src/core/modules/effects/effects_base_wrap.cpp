@@ -52,6 +52,9 @@
 // Forward declarations.
 //-----------------------------------------------------------------------------
 void export_base_temp_entity(scope);
+void export_temp_entity_field_type(scope);
+void export_temp_entity_layout(scope);
+void export_create_and_send(scope);
 
 
 //-----------------------------------------------------------------------------
@@ -60,6 +63,9 @@ void export_base_temp_entity(scope);
 DECLARE_SP_SUBMODULE(_effects, _base)
 {
 	export_base_temp_entity(_base);
+	export_temp_entity_field_type(_base);
+	export_temp_entity_layout(_base);
+	export_create_and_send(_base);
 }
 
 
@@ -97,3 +103,141 @@ void export_base_temp_entity(scope _base)
 		FUNCTION_INFO(Test)
 	END_CLASS_INFO()
 }
+
+
+//-----------------------------------------------------------------------------
+// Exports TempEntityFieldType_t.
+//-----------------------------------------------------------------------------
+void export_temp_entity_field_type(scope _base)
+{
+	enum_<TempEntityFieldType_t> TempEntityFieldType("TempEntityFieldType");
+
+	// Values...
+	TempEntityFieldType.value("INT", TE_FIELD_INT);
+	TempEntityFieldType.value("FLOAT", TE_FIELD_FLOAT);
+	TempEntityFieldType.value("VECTOR", TE_FIELD_VECTOR);
+	TempEntityFieldType.value("INDEX", TE_FIELD_INDEX);
+	TempEntityFieldType.value("COLOR", TE_FIELD_COLOR);
+}
+
+
+//-----------------------------------------------------------------------------
+// Exports CTempEntityLayout.
+//-----------------------------------------------------------------------------
+void export_temp_entity_layout(scope _base)
+{
+	class_<CTempEntityLayout, boost::noncopyable> TempEntityLayout(
+		"TempEntityLayout",
+		"Native alias layout of a temp entity template.",
+		init<unsigned int>(
+			"Initialize the layout.\n\n"
+			":param int size:\n"
+			"    The size of the temp entity instances the layout writes to.",
+			args("self", "size")
+		)
+	);
+
+	TempEntityLayout.def(
+		"add_field",
+		&CTempEntityLayout::AddField,
+		"Add an alias writing a single value at the given offset.\n\n"
+		":param str alias:\n"
+		"    The name of the alias.\n"
+		":param int offset:\n"
+		"    The offset of the property.\n"
+		":param TempEntityFieldType field_type:\n"
+		"    The type of the value to write.\n"
+		":param type cls:\n"
+		"    If given, values of an index field must be instances of this class.",
+		("alias", "offset", "field_type", arg("cls")=object())
+	);
+
+	TempEntityLayout.def(
+		"add_color",
+		&CTempEntityLayout::AddColor,
+		"Add an alias writing a color to its component offsets.\n\n"
+		":param str alias:\n"
+		"    The name of the alias.\n"
+		":param iterable offsets:\n"
+		"    The offsets of the red, green, blue and optional alpha properties.",
+		("alias", "offsets")
+	);
+
+	TempEntityLayout.def(
+		"__contains__",
+		&CTempEntityLayout::HasField,
+		"Return whether the given alias is part of the layout.\n\n"
+		":rtype: bool"
+	);
+
+	TempEntityLayout.def(
+		"__len__",
+		&CTempEntityLayout::GetFieldCount,
+		"Return the number of aliases of the layout.\n\n"
+		":rtype: int"
+	);
+
+	TempEntityLayout.add_property(
+		"size",
+		&CTempEntityLayout::GetSize,
+		"Return the size of the temp entity instances the layout writes to.\n\n"
+		":rtype: int"
+	);
+
+	TempEntityLayout.def(
+		"set_field",
+		&CTempEntityLayout::SetField,
+		"Write the given value of the given alias to the temp entity.\n\n"
+		":param BaseTempEntity temp_entity:\n"
+		"    The temp entity to write to.\n"
+		":param str alias:\n"
+		"    The name of the alias.\n"
+		":param value:\n"
+		"    The value to write.\n"
+		":raise NameError:\n"
+		"    Raised if the alias is not part of the layout.",
+		("temp_entity", "alias", "value")
+	);
+
+	TempEntityLayout.def(
+		"set_fields",
+		&CTempEntityLayout::SetFields,
+		"Write all the given aliases to the temp entity.\n\n"
+		":param BaseTempEntity temp_entity:\n"
+		"    The temp entity to write to.\n"
+		":param dict fields:\n"
+		"    The aliases and the values to write.",
+		("temp_entity", "fields")
+	);
+
+	TempEntityLayout.def(
+		"create_and_send",
+		&CTempEntityLayout::CreateAndSend,
+		"Copy the template, write the given aliases to the copy and create it.\n\n"
+		":param BaseTempEntity template:\n"
+		"    The template to copy.\n"
+		":param BaseRecipientFilter recipient_filter:\n"
+		"    The players to send the effect to.\n"
+		":param float delay:\n"
+		"    The delay before creating the effect.\n"
+		":param dict fields:\n"
+		"    The aliases and the values to write.",
+		("template", "recipient_filter", "delay", "fields")
+	);
+}
+
+
+//-----------------------------------------------------------------------------
+// Exports create_and_send.
+//-----------------------------------------------------------------------------
+void export_create_and_send(scope _base)
+{
+	def("create_and_send", raw_function(TempEntity_CreateAndSend, 2));
+	// Passing the doc string in combination with raw_function causes compiler errors :(
+	_base.attr("create_and_send").attr("__doc__") = "Fill and create a copy of the given template in one call.\n\n"
+		":param str/TempEntityTemplate template: The temp entity template or its name.\n"
+		":param recipients: A recipient filter, a player index or an iterable of players or indexes.\n"
+		":param float delay: The delay before creating the effect.\n"
+		":param **fields: The aliases to set before creating the effect.\n"
+		":raise NameError: Raised if an alias is not part of the template's native layout.";
+}
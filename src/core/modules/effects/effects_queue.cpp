@@ -0,0 +1,287 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2015 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+// Source.Python
+#include "effects_queue.h"
+#include "utilities/wrap_macros.h"
+
+// SDK
+#include "icvar.h"
+
+// STL
+#include <algorithm>
+
+
+//-----------------------------------------------------------------------------
+// Globals.
+//-----------------------------------------------------------------------------
+CTempEntityQueue g_TempEntityQueue;
+
+// Default of sv_multiplayer_maxtempentities
+#define DEFAULT_MAX_TEMP_ENTITIES 32
+
+// Alignment of the queued copies
+#define QUEUE_ALIGNMENT 16
+
+
+//-----------------------------------------------------------------------------
+// Sort helpers.
+//-----------------------------------------------------------------------------
+static bool SortByPriority(const QueuedTempEntity_t& a, const QueuedTempEntity_t& b)
+{
+	return a.m_iPriority > b.m_iPriority;
+}
+
+static bool SortByRecipients(const QueuedTempEntity_t& a, const QueuedTempEntity_t& b)
+{
+	int iResult = memcmp(a.m_Recipients.Base(), b.m_Recipients.Base(), a.m_Recipients.GetNumDWords() * sizeof(uint32));
+	if (iResult != 0)
+		return iResult < 0;
+
+	return a.m_iSequence < b.m_iSequence;
+}
+
+static bool HasSameRecipients(const QueuedTempEntity_t& a, const QueuedTempEntity_t& b)
+{
+	return memcmp(a.m_Recipients.Base(), b.m_Recipients.Base(), a.m_Recipients.GetNumDWords() * sizeof(uint32)) == 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// CTempEntityQueue constructor.
+//-----------------------------------------------------------------------------
+CTempEntityQueue::CTempEntityQueue()
+{
+	m_iMaxPerClient = -1;
+	m_pMaxTempEntities = NULL;
+	m_iDropped = 0;
+	m_iSent = 0;
+	m_iFilters = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// enqueue(template, recipients, delay=0.0, priority=0, **fields)
+//-----------------------------------------------------------------------------
+object CTempEntityQueue::Enqueue(tuple args, dict kwargs)
+{
+	int iArgCount = len(args);
+	if (iArgCount < 2 || iArgCount > 4)
+		BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Expected 2 to 4 positional arguments, got %d.", iArgCount);
+
+	object temp_entity_template = GetTempEntityTemplate(args[0]);
+	CBaseTempEntity* pTemplate = extract<CBaseTempEntity*>(temp_entity_template);
+	CTempEntityLayout* pLayout = extract<CTempEntityLayout*>(temp_entity_template.attr("layout"));
+
+	QueuedTempEntity_t entry;
+	entry.m_flDelay = 0;
+	entry.m_iPriority = 0;
+	entry.m_iSequence = (int) m_Entries.size();
+
+	if (iArgCount > 2)
+		entry.m_flDelay = extract<float>(args[2]);
+	else if (kwargs.has_key("delay"))
+		entry.m_flDelay = extract<float>(kwargs.attr("pop")("delay"));
+
+	if (iArgCount > 3)
+		entry.m_iPriority = extract<int>(args[3]);
+	else if (kwargs.has_key("priority"))
+		entry.m_iPriority = extract<int>(kwargs.attr("pop")("priority"));
+
+	MRecipientFilter filter;
+	AddTempEntityRecipients(filter, args[1]);
+	entry.m_Recipients = filter.m_Bits;
+
+	// Nobody would receive it
+	if (entry.m_Recipients.IsAllClear())
+		return object();
+
+	unsigned int uiOffset = (unsigned int) m_Storage.size();
+	uiOffset = (uiOffset + QUEUE_ALIGNMENT - 1) & ~(QUEUE_ALIGNMENT - 1);
+	m_Storage.resize(uiOffset + pLayout->GetSize());
+
+	try
+	{
+		pLayout->CopyTemplate(&m_Storage[uiOffset], pTemplate, kwargs);
+	}
+	catch (...)
+	{
+		m_Storage.resize(uiOffset);
+		throw;
+	}
+
+	entry.m_uiOffset = uiOffset;
+	m_Entries.push_back(entry);
+	return object();
+}
+
+
+//-----------------------------------------------------------------------------
+// Dispatches all queued temp entities. Called at the end of GameFrame.
+//-----------------------------------------------------------------------------
+void CTempEntityQueue::Flush()
+{
+	if (m_Entries.empty())
+		return;
+
+	m_Entries.swap(m_FlushEntries);
+	m_Storage.swap(m_FlushStorage);
+
+	m_iDropped = 0;
+	m_iSent = 0;
+	m_iFilters = 0;
+
+	// Give each recipient its budget in order of priority. Recipients that
+	// ran out of budget are removed from the remaining temp entities. A
+	// budget of 0 drops everything.
+	int iBudget = GetBudget();
+	if (iBudget >= 0)
+	{
+		std::stable_sort(m_FlushEntries.begin(), m_FlushEntries.end(), SortByPriority);
+
+		int iCounts[ABSOLUTE_PLAYER_LIMIT + 1] = {0};
+		for (std::vector<QueuedTempEntity_t>::iterator it = m_FlushEntries.begin(); it != m_FlushEntries.end(); ++it)
+		{
+			RecipientBits& recipients = it->m_Recipients;
+			for (int i = recipients.FindNextSetBit(0); i != -1; i = recipients.FindNextSetBit(i + 1))
+			{
+				if (iCounts[i] >= iBudget)
+					recipients.Clear(i);
+				else
+					++iCounts[i];
+			}
+		}
+	}
+
+	// Coalesce temp entities with the same recipients, so each recipient
+	// set only needs a single filter. Within a set, the queue order is kept.
+	std::sort(m_FlushEntries.begin(), m_FlushEntries.end(), SortByRecipients);
+
+	MRecipientFilter filter;
+	size_t nCount = m_FlushEntries.size();
+	for (size_t i = 0; i < nCount; )
+	{
+		size_t j = i + 1;
+		while (j < nCount && HasSameRecipients(m_FlushEntries[i], m_FlushEntries[j]))
+			++j;
+
+		filter.RemoveAllPlayers();
+
+		RecipientBits& recipients = m_FlushEntries[i].m_Recipients;
+		for (int iPlayer = recipients.FindNextSetBit(0); iPlayer != -1; iPlayer = recipients.FindNextSetBit(iPlayer + 1))
+			filter.AddRecipient(iPlayer);
+
+		if (filter.GetRecipientCount() == 0)
+		{
+			m_iDropped += (int) (j - i);
+		}
+		else
+		{
+			++m_iFilters;
+			for (size_t k = i; k < j; ++k)
+			{
+				CBaseTempEntity* pTempEntity = (CBaseTempEntity *) &m_FlushStorage[m_FlushEntries[k].m_uiOffset];
+				pTempEntity->Create(filter, m_FlushEntries[k].m_flDelay);
+				++m_iSent;
+			}
+		}
+
+		i = j;
+	}
+
+	m_FlushEntries.clear();
+	m_FlushStorage.clear();
+}
+
+
+//-----------------------------------------------------------------------------
+// Discards all queued temp entities.
+//-----------------------------------------------------------------------------
+void CTempEntityQueue::Clear()
+{
+	m_Entries.clear();
+	m_Storage.clear();
+}
+
+
+//-----------------------------------------------------------------------------
+// Returns the number of queued temp entities.
+//-----------------------------------------------------------------------------
+int CTempEntityQueue::GetCount()
+{
+	return (int) m_Entries.size();
+}
+
+
+//-----------------------------------------------------------------------------
+// Per-recipient budget.
+//-----------------------------------------------------------------------------
+int CTempEntityQueue::GetMaxPerClient()
+{
+	return m_iMaxPerClient;
+}
+
+void CTempEntityQueue::SetMaxPerClient(int iMaxPerClient)
+{
+	if (iMaxPerClient < -1)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Maximum per client must be -1 or greater.")
+
+	m_iMaxPerClient = iMaxPerClient;
+}
+
+int CTempEntityQueue::GetBudget()
+{
+	if (m_iMaxPerClient != -1)
+		return m_iMaxPerClient;
+
+	if (!m_pMaxTempEntities)
+		m_pMaxTempEntities = g_pCVar->FindVar("sv_multiplayer_maxtempentities");
+
+	return m_pMaxTempEntities ? m_pMaxTempEntities->GetInt() : DEFAULT_MAX_TEMP_ENTITIES;
+}
+
+
+//-----------------------------------------------------------------------------
+// Statistics of the last flush.
+//-----------------------------------------------------------------------------
+int CTempEntityQueue::GetDroppedCount()
+{
+	return m_iDropped;
+}
+
+int CTempEntityQueue::GetSentCount()
+{
+	return m_iSent;
+}
+
+int CTempEntityQueue::GetFilterCount()
+{
+	return m_iFilters;
+}
@@ -0,0 +1,106 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2015 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+#ifndef _EFFECTS_QUEUE_H
+#define _EFFECTS_QUEUE_H
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+// Source.Python
+#include "effects_base.h"
+#include "modules/filters/filters_recipients.h"
+
+// SDK
+#include "convar.h"
+
+// STL
+#include <vector>
+
+
+//-----------------------------------------------------------------------------
+// A temp entity waiting for the end of the frame.
+//-----------------------------------------------------------------------------
+struct QueuedTempEntity_t
+{
+	// Offset of the filled copy in CTempEntityQueue::m_Storage
+	unsigned int	m_uiOffset;
+	RecipientBits	m_Recipients;
+	float			m_flDelay;
+	int				m_iPriority;
+	int				m_iSequence;
+};
+
+
+//-----------------------------------------------------------------------------
+// Batches temp entities and dispatches them at the end of GameFrame.
+//-----------------------------------------------------------------------------
+class CTempEntityQueue
+{
+public:
+	CTempEntityQueue();
+
+	object Enqueue(tuple args, dict kwargs);
+
+	void Flush();
+	void Clear();
+
+	int GetCount();
+
+	int GetMaxPerClient();
+	void SetMaxPerClient(int iMaxPerClient);
+
+	int GetDroppedCount();
+	int GetSentCount();
+	int GetFilterCount();
+
+private:
+	int GetBudget();
+
+private:
+	std::vector<unsigned char>		m_Storage;
+	std::vector<QueuedTempEntity_t>	m_Entries;
+
+	// The queue is swapped into these while flushing, so effects queued by
+	// Create() hooks are sent with the next frame.
+	std::vector<unsigned char>		m_FlushStorage;
+	std::vector<QueuedTempEntity_t>	m_FlushEntries;
+
+	// -1 uses sv_multiplayer_maxtempentities
+	int			m_iMaxPerClient;
+	ConVar*		m_pMaxTempEntities;
+
+	// Statistics of the last flush
+	int			m_iDropped;
+	int			m_iSent;
+	int			m_iFilters;
+};
+
+extern CTempEntityQueue g_TempEntityQueue;
+
+
+#endif // _EFFECTS_QUEUE_H
@@ -0,0 +1,119 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2015 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#include "export_main.h"
+#include "utilities/wrap_macros.h"
+#include "effects_queue.h"
+
+
+//-----------------------------------------------------------------------------
+// Forward declarations.
+//-----------------------------------------------------------------------------
+void export_temp_entity_queue(scope);
+
+
+//-----------------------------------------------------------------------------
+// Declare the _effects._queue module.
+//-----------------------------------------------------------------------------
+DECLARE_SP_SUBMODULE(_effects, _queue)
+{
+	export_temp_entity_queue(_queue);
+}
+
+
+//-----------------------------------------------------------------------------
+// Exports CTempEntityQueue.
+//-----------------------------------------------------------------------------
+void export_temp_entity_queue(scope _queue)
+{
+	class_<CTempEntityQueue, boost::noncopyable> TempEntityQueue("TempEntityQueue", no_init);
+
+	TempEntityQueue.def(
+		"enqueue",
+		raw_method(&CTempEntityQueue::Enqueue),
+		"Queue a temp entity that is sent at the end of the current frame.\n\n"
+		":param str/TempEntityTemplate template:\n"
+		"    The temp entity template or its name.\n"
+		":param recipients:\n"
+		"    A recipient filter, a player index or an iterable of players or indexes.\n"
+		":param float delay:\n"
+		"    The delay before creating the effect.\n"
+		":param int priority:\n"
+		"    Temp entities with a higher priority are kept first if a recipient\n"
+		"    is over budget.\n"
+		":param **fields:\n"
+		"    The aliases to set before creating the effect.");
+
+	TempEntityQueue.def(
+		"flush",
+		&CTempEntityQueue::Flush,
+		"Send all queued temp entities now. "
+		"This is done automatically at the end of every frame.");
+
+	TempEntityQueue.def(
+		"clear",
+		&CTempEntityQueue::Clear,
+		"Discard all queued temp entities.");
+
+	TempEntityQueue.def(
+		"__len__",
+		&CTempEntityQueue::GetCount,
+		"Return the number of queued temp entities.\n\n"
+		":rtype: int");
+
+	TempEntityQueue.add_property(
+		"max_per_client",
+		&CTempEntityQueue::GetMaxPerClient,
+		&CTempEntityQueue::SetMaxPerClient,
+		"The maximum number of temp entities sent to a single player per frame. "
+		"-1 uses sv_multiplayer_maxtempentities and 0 sends nothing.\n\n"
+		":rtype: int\n"
+		":raise ValueError: Raised if the value is less than -1.");
+
+	TempEntityQueue.add_property(
+		"dropped_count",
+		&CTempEntityQueue::GetDroppedCount,
+		"Return the number of temp entities dropped by the last flush.\n\n"
+		":rtype: int");
+
+	TempEntityQueue.add_property(
+		"sent_count",
+		&CTempEntityQueue::GetSentCount,
+		"Return the number of temp entities sent by the last flush.\n\n"
+		":rtype: int");
+
+	TempEntityQueue.add_property(
+		"filter_count",
+		&CTempEntityQueue::GetFilterCount,
+		"Return the number of distinct recipient sets of the last flush.\n\n"
+		":rtype: int");
+
+	_queue.attr("temp_entity_queue") = object(ptr(&g_TempEntityQueue));
+}
@@ -61,6 +61,7 @@
 //---------------------------------------------------------------------------------
 extern IVEngineServer* engine;
 extern IServerGameDLL* servergamedll;
+extern IServerGameEnts* servergameents;
 
 
 //---------------------------------------------------------------------------------
@@ -69,6 +70,7 @@ extern IServerGameDLL* servergamedll;
 static void export_engine_server(scope);
 static void export_query_cvar_status(scope);
 static void export_server_game_dll(scope);
+static void export_server_game_ents(scope);
 static void export_iserver(scope);
 static void export_functions(scope);
 
@@ -81,6 +83,7 @@ DECLARE_SP_SUBMODULE(_engines, _server)
 	export_engine_server(_server);
 	export_query_cvar_status(_server);
 	export_server_game_dll(_server);
+	export_server_game_ents(_server);
 	export_iserver(_server);
 	export_functions(_server);
 }
@@ -833,6 +836,26 @@ static void export_server_game_dll(scope _server)
 }
 
 
+//-----------------------------------------------------------------------------
+// Exports IServerGameEnts.
+//-----------------------------------------------------------------------------
+static void export_server_game_ents(scope _server)
+{
+	class_<IServerGameEnts, boost::noncopyable> ServerGameEnts("_ServerGameEnts", no_init);
+
+	// Class info...
+	BEGIN_CLASS_INFO(IServerGameEnts)
+		FUNCTION_INFO(CheckTransmit)
+	END_CLASS_INFO()
+
+	// Add memory tools...
+	ServerGameEnts ADD_MEM_TOOLS(IServerGameEnts);
+
+	// Singleton...
+	_server.attr("server_game_ents") = object(ptr(servergameents));
+}
+
+
 //-----------------------------------------------------------------------------
 // Exports IServer.
 //-----------------------------------------------------------------------------
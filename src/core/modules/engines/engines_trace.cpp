@@ -0,0 +1,267 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2016 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+// Source.Python
+#include "engines_trace.h"
+#include "utilities/conversions.h"
+#include "utilities/wrap_macros.h"
+#include "modules/entities/entities_entity.h"
+
+// SDK
+#include "mathlib/vector.h"
+
+
+//-----------------------------------------------------------------------------
+// CNativeTraceFilter.
+//-----------------------------------------------------------------------------
+CNativeTraceFilter::CNativeTraceFilter(TraceType_t eTraceType)
+{
+	m_eTraceType = eTraceType;
+	m_uiIgnoredCollisionGroups = 0;
+	m_uiIgnoredTeams = 0;
+	m_bPlayersOnly = false;
+}
+
+boost::shared_ptr<CNativeTraceFilter> CNativeTraceFilter::__init__(object ignore, TraceType_t eTraceType)
+{
+	boost::shared_ptr<CNativeTraceFilter> pFilter(new CNativeTraceFilter(eTraceType));
+
+	list entities(ignore);
+	for (int i = 0; i < len(entities); i++)
+	{
+		extract<unsigned int> index(entities[i]);
+		pFilter->AddIgnored(index.check() ? index() : extract<unsigned int>(entities[i].attr("index"))());
+	}
+
+	return pFilter;
+}
+
+bool CNativeTraceFilter::ShouldHitEntity(IHandleEntity* pHandleEntity, int contentsMask)
+{
+	unsigned int uiIndex;
+	if (!IndexFromBaseHandle(pHandleEntity->GetRefEHandle(), uiIndex))
+	{
+		// Static props don't have an index
+		return !m_bPlayersOnly;
+	}
+
+	if (m_Ignored.IsBitSet(uiIndex))
+		return false;
+
+	// Always hit the world, unless it has been ignored
+	if (uiIndex == WORLD_ENTITY_INDEX)
+		return true;
+
+	if (m_bPlayersOnly && uiIndex > (unsigned int) gpGlobals->maxClients)
+		return false;
+
+	if (!m_uiIgnoredCollisionGroups && !m_uiIgnoredTeams && m_IgnoredClassnames.empty())
+		return true;
+
+	CBaseEntity* pBaseEntity;
+	if (!BaseEntityFromIndex(uiIndex, pBaseEntity))
+		return true;
+
+	CBaseEntityWrapper* pEntity = (CBaseEntityWrapper*) pBaseEntity;
+	if (m_uiIgnoredCollisionGroups)
+	{
+		int iGroup = pEntity->GetCollisionGroup();
+		if (iGroup >= 0 && iGroup < 32 && (m_uiIgnoredCollisionGroups & (1u << iGroup)))
+			return false;
+	}
+
+	if (m_uiIgnoredTeams)
+	{
+		int iTeam = pEntity->GetTeamIndex();
+		if (iTeam >= 0 && iTeam < 32 && (m_uiIgnoredTeams & (1u << iTeam)))
+			return false;
+	}
+
+	if (!m_IgnoredClassnames.empty())
+	{
+		const char* szClassname = IServerUnknownExt::GetClassname(pBaseEntity);
+		for (std::vector<std::string>::const_iterator it = m_IgnoredClassnames.begin(); it != m_IgnoredClassnames.end(); ++it)
+		{
+			if (strcmp(it->c_str(), szClassname) == 0)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+TraceType_t CNativeTraceFilter::GetTraceType() const
+{
+	return m_eTraceType;
+}
+
+void CNativeTraceFilter::SetTraceType(TraceType_t eTraceType)
+{
+	m_eTraceType = eTraceType;
+}
+
+void CNativeTraceFilter::AddIgnored(unsigned int uiIndex)
+{
+	if (uiIndex >= MAX_EDICTS)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Invalid entity index: %u.", uiIndex)
+
+	m_Ignored.Set(uiIndex);
+}
+
+void CNativeTraceFilter::RemoveIgnored(unsigned int uiIndex)
+{
+	if (uiIndex >= MAX_EDICTS)
+		return;
+
+	m_Ignored.Clear(uiIndex);
+}
+
+bool CNativeTraceFilter::IsIgnored(unsigned int uiIndex)
+{
+	if (uiIndex >= MAX_EDICTS)
+		return false;
+
+	return m_Ignored.IsBitSet(uiIndex);
+}
+
+void CNativeTraceFilter::ClearIgnored()
+{
+	m_Ignored.ClearAll();
+}
+
+void CNativeTraceFilter::AddIgnoredClassname(const char* szClassname)
+{
+	m_IgnoredClassnames.push_back(szClassname);
+}
+
+void CNativeTraceFilter::ClearIgnoredClassnames()
+{
+	m_IgnoredClassnames.clear();
+}
+
+
+//-----------------------------------------------------------------------------
+// Packed float arrays.
+//-----------------------------------------------------------------------------
+class CPackedVectors
+{
+public:
+	CPackedVectors(object obj, const char* szName)
+	{
+		if (PyObject_GetBuffer(obj.ptr(), &m_View, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0)
+			throw_error_already_set();
+
+		// Accept float arrays and raw bytes of packed floats
+		const char* szFormat = m_View.format;
+		bool bFloats = !szFormat || strcmp(szFormat, "f") == 0 || strcmp(szFormat, "<f") == 0 || strcmp(szFormat, "=f") == 0;
+		bool bBytes = szFormat && strcmp(szFormat, "B") == 0;
+
+		if ((!bFloats && !bBytes) || m_View.len % (3 * sizeof(float)) != 0)
+		{
+			PyBuffer_Release(&m_View);
+			BOOST_RAISE_EXCEPTION(PyExc_ValueError, "'%s' must be a buffer of packed float triples.", szName)
+		}
+	}
+
+	~CPackedVectors()
+	{
+		PyBuffer_Release(&m_View);
+	}
+
+	int GetCount()
+	{ return (int) (m_View.len / (3 * sizeof(float))); }
+
+	Vector Get(int iIndex)
+	{
+		const float* pData = (const float*) m_View.buf + iIndex * 3;
+		return Vector(pData[0], pData[1], pData[2]);
+	}
+
+private:
+	Py_buffer m_View;
+};
+
+
+//-----------------------------------------------------------------------------
+// Functions.
+//-----------------------------------------------------------------------------
+object TraceRays(IEngineTrace* pEngineTrace, object starts, object ends, unsigned int mask,
+	ITraceFilter* pFilter, object mins, object maxs)
+{
+	CPackedVectors vecStarts(starts, "starts");
+	CPackedVectors vecEnds(ends, "ends");
+
+	int iCount = vecStarts.GetCount();
+	if (vecEnds.GetCount() != iCount)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "'starts' and 'ends' must contain the same number of vectors.")
+
+	bool bHull = !mins.is_none() || !maxs.is_none();
+	Vector vecMins = bHull ? extract<Vector>(mins)() : vec3_origin;
+	Vector vecMaxs = bHull ? extract<Vector>(maxs)() : vec3_origin;
+
+	// Use a filter that hits everything if none was given
+	CNativeTraceFilter defaultFilter;
+	if (!pFilter)
+		pFilter = &defaultFilter;
+
+	PyObject* pResult = PyByteArray_FromStringAndSize(NULL, iCount * sizeof(TraceResult_t));
+	if (!pResult)
+		throw_error_already_set();
+
+	object result = object(handle<>(pResult));
+	TraceResult_t* pResults = (TraceResult_t*) PyByteArray_AS_STRING(pResult);
+
+	Ray_t ray;
+	CGameTrace trace;
+	for (int i = 0; i < iCount; i++)
+	{
+		if (bHull)
+			ray.Init(vecStarts.Get(i), vecEnds.Get(i), vecMins, vecMaxs);
+		else
+			ray.Init(vecStarts.Get(i), vecEnds.Get(i));
+
+		pEngineTrace->TraceRay(ray, mask, pFilter, &trace);
+
+		TraceResult_t& output = pResults[i];
+		output.m_fFraction = trace.fraction;
+		output.m_vecEnd[0] = trace.endpos.x;
+		output.m_vecEnd[1] = trace.endpos.y;
+		output.m_vecEnd[2] = trace.endpos.z;
+		output.m_iHitGroup = trace.hitgroup;
+		output.m_vecNormal[0] = trace.plane.normal.x;
+		output.m_vecNormal[1] = trace.plane.normal.y;
+		output.m_vecNormal[2] = trace.plane.normal.z;
+
+		unsigned int uiIndex;
+		output.m_iEntityIndex = (trace.m_pEnt && IndexFromBaseEntity(trace.m_pEnt, uiIndex)) ? (int) uiIndex : -1;
+	}
+
+	return result;
+}
@@ -0,0 +1,114 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2016 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+#ifndef _ENGINES_TRACE_H
+#define _ENGINES_TRACE_H
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+// C++
+#include <string>
+#include <vector>
+
+// Boost.Python
+#include "boost/python.hpp"
+using namespace boost::python;
+
+// SDK
+#include "engine/IEngineTrace.h"
+#include "bitvec.h"
+#include "const.h"
+
+
+//-----------------------------------------------------------------------------
+// A trace filter that is evaluated in C++ only.
+//-----------------------------------------------------------------------------
+class CNativeTraceFilter: public ITraceFilter
+{
+public:
+	CNativeTraceFilter(TraceType_t eTraceType = TRACE_EVERYTHING);
+
+	// Accepts entity indexes or objects with an index attribute
+	static boost::shared_ptr<CNativeTraceFilter> __init__(object ignore, TraceType_t eTraceType);
+
+	virtual bool ShouldHitEntity(IHandleEntity* pHandleEntity, int contentsMask);
+	virtual TraceType_t GetTraceType() const;
+
+	void SetTraceType(TraceType_t eTraceType);
+
+	// Ignored entities
+	void AddIgnored(unsigned int uiIndex);
+	void RemoveIgnored(unsigned int uiIndex);
+	bool IsIgnored(unsigned int uiIndex);
+	void ClearIgnored();
+
+	// Ignored classnames
+	void AddIgnoredClassname(const char* szClassname);
+	void ClearIgnoredClassnames();
+
+public:
+	// Bits of the collision groups and teams that are not hit
+	unsigned int	m_uiIgnoredCollisionGroups;
+	unsigned int	m_uiIgnoredTeams;
+
+	// If true, only players and the world are hit
+	bool			m_bPlayersOnly;
+
+private:
+	TraceType_t					m_eTraceType;
+	CBitVec<MAX_EDICTS>			m_Ignored;
+	std::vector<std::string>	m_IgnoredClassnames;
+};
+
+
+//-----------------------------------------------------------------------------
+// Result of a single trace of a batch.
+//-----------------------------------------------------------------------------
+struct TraceResult_t
+{
+	float	m_fFraction;
+	float	m_vecEnd[3];
+	int		m_iEntityIndex;
+	int		m_iHitGroup;
+	float	m_vecNormal[3];
+};
+
+// struct module format of TraceResult_t
+#define TRACE_RESULT_FORMAT "=f3fii3f"
+
+
+//-----------------------------------------------------------------------------
+// Functions.
+//-----------------------------------------------------------------------------
+// Traces all rays of the given packed float arrays and returns a bytearray
+// of TraceResult_t structures
+object TraceRays(IEngineTrace* pEngineTrace, object starts, object ends, unsigned int mask,
+	ITraceFilter* pFilter, object mins, object maxs);
+
+
+#endif // _ENGINES_TRACE_H
@@ -31,6 +31,8 @@
 #include "export_main.h"
 #include "utilities/conversions.h"
 #include "engines.h"
+#include "engines_trace.h"
+#include "engines_visibility.h"
 #include ENGINE_INCLUDE_PATH(engines_wrap.h)
 
 // SDK
@@ -55,6 +57,8 @@ void export_displacement_flags(scope);
 void export_game_trace(scope);
 void export_surface_t(scope);
 void export_trace_filter(scope);
+void export_native_trace_filter(scope);
+void export_visibility_matrix(scope);
 void export_entity_enumerator(scope);
 void export_trace_type_t(scope);
 void export_content_flags(scope);
@@ -75,6 +79,8 @@ DECLARE_SP_SUBMODULE(_engines, _trace)
 	export_game_trace(_trace);
 	export_surface_t(_trace);
 	export_trace_filter(_trace);
+	export_native_trace_filter(_trace);
+	export_visibility_matrix(_trace);
 	export_entity_enumerator(_trace);
 	export_trace_type_t(_trace);
 
@@ -138,6 +144,29 @@ void export_engine_trace(scope _trace)
 			args("ray", "mask", "filter", "trace")
 		)
 
+		.def("trace_rays",
+			&TraceRays,
+			"Trace multiple rays in one call.\n\n"
+			":param starts:\n"
+			"    A buffer of packed float triples that contains the start positions.\n"
+			":param ends:\n"
+			"    A buffer of packed float triples that contains the end positions.\n"
+			":param int mask:\n"
+			"    Contents the rays can possibly collide with.\n"
+			":param TraceFilter filter:\n"
+			"    The filter to use. If None, everything is hit.\n"
+			":param Vector mins:\n"
+			"    If given together with maxs, hulls are traced.\n"
+			":param Vector maxs:\n"
+			"    If given together with mins, hulls are traced.\n"
+			":return:\n"
+			"    A bytearray of packed results. Each result contains the fraction, the\n"
+			"    end position, the index of the hit entity (-1 if none), the hitgroup\n"
+			"    and the plane normal. Use :attr:`TRACE_RESULT_FORMAT` to unpack it.\n"
+			":rtype: bytearray",
+			(arg("starts"), arg("ends"), arg("mask"), arg("filter")=object(), arg("mins")=object(), arg("maxs")=object())
+		)
+
 		.def("enumerate_entities",
 			GET_METHOD(void, IEngineTrace, EnumerateEntities, const Ray_t&, bool, IEntityEnumerator*),
 			"Enumerates over all entities along a ray.",
@@ -181,6 +210,7 @@ void export_engine_trace(scope _trace)
 	;
 
 	_trace.attr("engine_trace") = object(ptr(enginetrace));
+	_trace.attr("TRACE_RESULT_FORMAT") = TRACE_RESULT_FORMAT;
 }
 
 
@@ -361,6 +391,165 @@ void export_trace_filter(scope _trace)
 }
 
 
+//-----------------------------------------------------------------------------
+// Exports CNativeTraceFilter
+//-----------------------------------------------------------------------------
+void export_native_trace_filter(scope _trace)
+{
+	class_<CNativeTraceFilter, boost::shared_ptr<CNativeTraceFilter>, bases<ITraceFilter>, boost::noncopyable> NativeTraceFilter(
+		"NativeTraceFilter",
+		"A trace filter that is evaluated without calling back into Python.",
+		no_init
+	);
+
+	NativeTraceFilter.def(
+		"__init__",
+		make_constructor(
+			&CNativeTraceFilter::__init__,
+			default_call_policies(),
+			(arg("ignore")=tuple(), arg("trace_type")=TRACE_EVERYTHING)
+		),
+		"Initialize the filter.\n\n"
+		":param iterable ignore:\n"
+		"    An iterable of entities or entity indexes to ignore.\n"
+		":param TraceType trace_type:\n"
+		"    The trace type that should be used."
+	);
+
+	NativeTraceFilter.add_property(
+		"trace_type",
+		&CNativeTraceFilter::GetTraceType,
+		&CNativeTraceFilter::SetTraceType,
+		"Return the trace type.\n\n"
+		":rtype: TraceType");
+
+	NativeTraceFilter.def_readwrite(
+		"ignored_collision_groups",
+		&CNativeTraceFilter::m_uiIgnoredCollisionGroups,
+		"Bits of the collision groups that are not hit, e.g. ``1 << group``.");
+
+	NativeTraceFilter.def_readwrite(
+		"ignored_teams",
+		&CNativeTraceFilter::m_uiIgnoredTeams,
+		"Bits of the teams that are not hit, e.g. ``1 << team``.");
+
+	NativeTraceFilter.def_readwrite(
+		"players_only",
+		&CNativeTraceFilter::m_bPlayersOnly,
+		"If True, only players and the world are hit.");
+
+	NativeTraceFilter.def(
+		"add_ignored",
+		&CNativeTraceFilter::AddIgnored,
+		"Ignore the given entity.\n\n"
+		":param int index:\n"
+		"    The index of the entity.",
+		args("index"));
+
+	NativeTraceFilter.def(
+		"remove_ignored",
+		&CNativeTraceFilter::RemoveIgnored,
+		"Stop ignoring the given entity.\n\n"
+		":param int index:\n"
+		"    The index of the entity.",
+		args("index"));
+
+	NativeTraceFilter.def(
+		"is_ignored",
+		&CNativeTraceFilter::IsIgnored,
+		"Return whether the given entity is ignored.\n\n"
+		":param int index:\n"
+		"    The index of the entity.\n"
+		":rtype: bool",
+		args("index"));
+
+	NativeTraceFilter.def(
+		"clear_ignored",
+		&CNativeTraceFilter::ClearIgnored,
+		"Stop ignoring all entities.");
+
+	NativeTraceFilter.def(
+		"add_ignored_classname",
+		&CNativeTraceFilter::AddIgnoredClassname,
+		"Ignore all entities with the given classname.\n\n"
+		":param str classname:\n"
+		"    The classname to ignore.",
+		args("classname"));
+
+	NativeTraceFilter.def(
+		"clear_ignored_classnames",
+		&CNativeTraceFilter::ClearIgnoredClassnames,
+		"Stop ignoring all classnames.");
+
+	NativeTraceFilter ADD_MEM_TOOLS(CNativeTraceFilter);
+}
+
+
+//-----------------------------------------------------------------------------
+// Exports CVisibilityMatrix
+//-----------------------------------------------------------------------------
+void export_visibility_matrix(scope _trace)
+{
+	class_<CVisibilityMatrix, boost::noncopyable> VisibilityMatrix("VisibilityMatrix", no_init);
+
+	VisibilityMatrix.add_property(
+		"enabled",
+		&CVisibilityMatrix::GetEnabled,
+		&CVisibilityMatrix::SetEnabled,
+		"If True, the matrix is updated automatically. Disabling it marks all "
+		"players as visible again.\n\n"
+		":rtype: bool");
+
+	VisibilityMatrix.def_readwrite(
+		"update_interval",
+		&CVisibilityMatrix::m_iUpdateInterval,
+		"Number of ticks between two updates. The last result is reused in between.");
+
+	VisibilityMatrix.def_readwrite(
+		"mask",
+		&CVisibilityMatrix::m_uiMask,
+		"Contents that block the line of sight.");
+
+	VisibilityMatrix.def_readwrite(
+		"use_pvs",
+		&CVisibilityMatrix::m_bUsePVS,
+		"If True, players outside of each other's PVS are not traced.");
+
+	VisibilityMatrix.add_property(
+		"last_update_tick",
+		&CVisibilityMatrix::GetLastUpdateTick,
+		"Return the tick of the last update or -1 if there is none.\n\n"
+		":rtype: int");
+
+	VisibilityMatrix.def(
+		"update",
+		&CVisibilityMatrix::ForceUpdate,
+		"Update the matrix now.");
+
+	VisibilityMatrix.def(
+		"is_visible",
+		&CVisibilityMatrix::IsVisible,
+		"Return whether the target is visible to the observer.\n\n"
+		":param int observer:\n"
+		"    The index of the observing player.\n"
+		":param int target:\n"
+		"    The index of the target player.\n"
+		":rtype: bool",
+		args("observer", "target"));
+
+	VisibilityMatrix.def(
+		"get_visible_players",
+		&CVisibilityMatrix::GetVisiblePlayers,
+		"Return the indexes of all players that are visible to the observer.\n\n"
+		":param int observer:\n"
+		"    The index of the observing player.\n"
+		":rtype: list",
+		args("observer"));
+
+	_trace.attr("visibility_matrix") = object(ptr(&g_VisibilityMatrix));
+}
+
+
 //-----------------------------------------------------------------------------
 // Exports csurface_t
 //-----------------------------------------------------------------------------
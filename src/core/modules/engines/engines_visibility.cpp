@@ -0,0 +1,197 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2016 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+// Source.Python
+#include "engines_visibility.h"
+#include "engines_trace.h"
+#include "utilities/conversions.h"
+#include "modules/entities/entities_entity.h"
+#include "modules/players/players_state.h"
+
+// SDK
+#include "eiface.h"
+
+
+//-----------------------------------------------------------------------------
+// External variables.
+//-----------------------------------------------------------------------------
+extern IVEngineServer* engine;
+extern IEngineTrace* enginetrace;
+extern CGlobalVars* gpGlobals;
+
+
+//-----------------------------------------------------------------------------
+// Globals.
+//-----------------------------------------------------------------------------
+CVisibilityMatrix g_VisibilityMatrix;
+
+
+//-----------------------------------------------------------------------------
+// CVisibilityMatrix.
+//-----------------------------------------------------------------------------
+CVisibilityMatrix::CVisibilityMatrix()
+{
+	m_bEnabled = false;
+	m_iUpdateInterval = 1;
+	m_uiMask = MASK_OPAQUE;
+	m_bUsePVS = true;
+	Invalidate();
+}
+
+void CVisibilityMatrix::OnTick()
+{
+	if (!m_bEnabled)
+		return;
+
+	// Reuse the last result until the interval has passed
+	if (m_iLastTick != -1 && gpGlobals->tickcount - m_iLastTick < m_iUpdateInterval
+		&& gpGlobals->tickcount >= m_iLastTick)
+		return;
+
+	ForceUpdate();
+}
+
+void CVisibilityMatrix::ForceUpdate()
+{
+	m_iLastTick = gpGlobals->tickcount;
+	g_PlayerStateTable.Update();
+
+	int iMaxClients = gpGlobals->maxClients;
+	Vector vecEyes[VISIBILITY_SLOTS];
+	Vector vecCenters[VISIBILITY_SLOTS];
+	bool bAlive[VISIBILITY_SLOTS];
+
+	// Players never block the line of sight to other players
+	CNativeTraceFilter filter;
+	for (int i=1; i <= iMaxClients; i++)
+	{
+		m_Rows[i].SetAll();
+		filter.AddIgnored(i);
+
+		bAlive[i] = false;
+		if (!g_PlayerStateTable.IsConnected(i) || !g_PlayerStateTable.IsAlive(i))
+			continue;
+
+		CBaseEntity* pBaseEntity;
+		if (!BaseEntityFromIndex(i, pBaseEntity))
+			continue;
+
+		CBaseEntityWrapper* pEntity = (CBaseEntityWrapper*) pBaseEntity;
+		vecEyes[i] = pEntity->GetEyeLocation();
+		vecCenters[i] = g_PlayerStateTable.GetOrigin(i) + (pEntity->GetMins() + pEntity->GetMaxs()) * 0.5f;
+		bAlive[i] = true;
+	}
+
+	for (int i=1; i <= iMaxClients; i++)
+	{
+		if (!bAlive[i])
+			continue;
+
+		if (m_bUsePVS)
+		{
+			int iCluster = engine->GetClusterForOrigin(vecEyes[i]);
+			engine->GetPVSForCluster(iCluster, sizeof(m_ucPVS), m_ucPVS);
+		}
+
+		for (int j=i+1; j <= iMaxClients; j++)
+		{
+			if (!bAlive[j])
+				continue;
+
+			// The eye to eye trace is shared by both directions, but the eye
+			// to center traces are not symmetric
+			bool bVisibleToI = false;
+			bool bVisibleToJ = false;
+			if (!m_bUsePVS || engine->CheckOriginInPVS(vecEyes[j], m_ucPVS, sizeof(m_ucPVS)))
+			{
+				bool bEyes = IsLineOfSight(vecEyes[i], vecEyes[j], &filter);
+				bVisibleToI = bEyes || IsLineOfSight(vecEyes[i], vecCenters[j], &filter);
+				bVisibleToJ = bEyes || IsLineOfSight(vecEyes[j], vecCenters[i], &filter);
+			}
+
+			if (!bVisibleToI)
+				m_Rows[i].Clear(j);
+
+			if (!bVisibleToJ)
+				m_Rows[j].Clear(i);
+		}
+	}
+}
+
+void CVisibilityMatrix::Invalidate()
+{
+	m_iLastTick = -1;
+	for (int i=0; i < VISIBILITY_SLOTS; i++)
+		m_Rows[i].SetAll();
+}
+
+list CVisibilityMatrix::GetVisiblePlayers(unsigned int uiObserver)
+{
+	if (uiObserver == WORLD_ENTITY_INDEX || uiObserver >= VISIBILITY_SLOTS)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Invalid player index: %u.", uiObserver)
+
+	list result;
+	for (int i=1; i <= gpGlobals->maxClients; i++)
+	{
+		if (i != (int) uiObserver && g_PlayerStateTable.IsConnected(i) && m_Rows[uiObserver].IsBitSet(i))
+			result.append(i);
+	}
+
+	return result;
+}
+
+int CVisibilityMatrix::GetLastUpdateTick()
+{
+	return m_iLastTick;
+}
+
+bool CVisibilityMatrix::GetEnabled()
+{
+	return m_bEnabled;
+}
+
+void CVisibilityMatrix::SetEnabled(bool bEnabled)
+{
+	m_bEnabled = bEnabled;
+
+	// Don't keep hiding players with the rows of the last update
+	if (!bEnabled)
+		Invalidate();
+}
+
+bool CVisibilityMatrix::IsLineOfSight(const Vector& vecStart, const Vector& vecEnd, ITraceFilter* pFilter)
+{
+	Ray_t ray;
+	ray.Init(vecStart, vecEnd);
+
+	CGameTrace trace;
+	enginetrace->TraceRay(ray, m_uiMask, pFilter, &trace);
+	return trace.fraction >= 1.0f;
+}
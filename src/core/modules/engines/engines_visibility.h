@@ -0,0 +1,101 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2016 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+#ifndef _ENGINES_VISIBILITY_H
+#define _ENGINES_VISIBILITY_H
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+// Boost.Python
+#include "boost/python.hpp"
+using namespace boost::python;
+
+// SDK
+#include "bitvec.h"
+#include "const.h"
+#include "bspfile.h"
+
+
+//-----------------------------------------------------------------------------
+// Constants.
+//-----------------------------------------------------------------------------
+#define VISIBILITY_SLOTS (ABSOLUTE_PLAYER_LIMIT + 1)
+
+typedef CBitVec<VISIBILITY_SLOTS> VisibilityRow;
+
+
+//-----------------------------------------------------------------------------
+// Player to player visibility, computed natively every few ticks.
+//
+// Only alive players are traced. Pairs that involve a dead or disconnected
+// player are always visible, so transmit filters never hide them.
+//-----------------------------------------------------------------------------
+class CVisibilityMatrix
+{
+public:
+	CVisibilityMatrix();
+
+	// Called once per server frame
+	void OnTick();
+
+	void ForceUpdate();
+	void Invalidate();
+
+	bool IsVisible(unsigned int uiObserver, unsigned int uiTarget)
+	{
+		if (uiObserver >= VISIBILITY_SLOTS || uiTarget >= VISIBILITY_SLOTS)
+			return true;
+
+		return m_Rows[uiObserver].IsBitSet(uiTarget);
+	}
+
+	list GetVisiblePlayers(unsigned int uiObserver);
+	int GetLastUpdateTick();
+
+	bool GetEnabled();
+	void SetEnabled(bool bEnabled);
+
+private:
+	bool IsLineOfSight(const Vector& vecStart, const Vector& vecEnd, ITraceFilter* pFilter);
+
+public:
+	int				m_iUpdateInterval;
+	unsigned int	m_uiMask;
+	bool			m_bUsePVS;
+
+private:
+	bool			m_bEnabled;
+	int				m_iLastTick;
+	VisibilityRow	m_Rows[VISIBILITY_SLOTS];
+	unsigned char	m_ucPVS[MAX_MAP_CLUSTERS / 8];
+};
+
+extern CVisibilityMatrix g_VisibilityMatrix;
+
+
+#endif // _ENGINES_VISIBILITY_H
@@ -490,6 +490,11 @@ Vector CBaseEntityWrapper::GetOrigin()
 	return GetKeyValueVector("origin");
 }
 
+void CBaseEntityWrapper::GetOriginInto(Vector& output)
+{
+	output = GetOrigin();
+}
+
 void CBaseEntityWrapper::SetOrigin(Vector& vec)
 {
 	// Use KeyValue method, because it does a lot more under the rug than
@@ -683,6 +688,11 @@ QAngle CBaseEntityWrapper::GetAngles()
 	return GetKeyValueQAngle("angles");
 }
 
+void CBaseEntityWrapper::GetAnglesInto(QAngle& output)
+{
+	output = GetAngles();
+}
+
 void CBaseEntityWrapper::SetAngles(QAngle& angles)
 {
 	SetKeyValueQAngle("angles", angles);
@@ -952,6 +962,11 @@ Vector CBaseEntityWrapper::GetVelocity()
 	return GetDatamapPropertyByOffset<Vector>(offset);
 }
 
+void CBaseEntityWrapper::GetVelocityInto(Vector& output)
+{
+	output = GetVelocity();
+}
+
 void CBaseEntityWrapper::SetVelocity(Vector& vec)
 {
 	static int offset = FindDatamapPropertyOffset("m_vecVelocity");
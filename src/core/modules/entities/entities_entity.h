@@ -316,6 +316,7 @@ public:
 	bool IsWeapon();
 
 	Vector GetOrigin();
+	void GetOriginInto(Vector& output);
 	void SetOrigin(Vector& vec);
 
 	Vector GetMaxs();
@@ -361,6 +362,7 @@ public:
 	void SetParentHandle(int entity);
 
 	QAngle GetAngles();
+	void GetAnglesInto(QAngle& output);
 	void SetAngles(QAngle& angles);
 
 	str GetTargetName();
@@ -418,6 +420,7 @@ public:
 	void SetTarget(const char* target);
 
 	Vector GetVelocity();
+	void GetVelocityInto(Vector& output);
 	void SetVelocity(Vector& velocity);
 
 	Vector GetViewOffset();
@@ -117,6 +117,13 @@ void export_base_entity(scope _entity)
 		":rtype: Vector"
 	);
 
+	BaseEntity.def("get_origin_into",
+		&CBaseEntityWrapper::GetOriginInto,
+		"Write the entity's origin into an existing vector.\n\n"
+		":param Vector output: The vector to write to.",
+		args("output")
+	);
+
 	BaseEntity.add_property(
 		"maxs",
 		&CBaseEntityWrapper::GetMaxs,
@@ -239,6 +246,13 @@ void export_base_entity(scope _entity)
 		":rtype: QAngle"
 	);
 
+	BaseEntity.def("get_angles_into",
+		&CBaseEntityWrapper::GetAnglesInto,
+		"Write the entity's angles into an existing angle.\n\n"
+		":param QAngle output: The angle to write to.",
+		args("output")
+	);
+
 	BaseEntity.add_property(
 		"target_name",
 		&CBaseEntityWrapper::GetTargetName,
@@ -401,6 +415,13 @@ void export_base_entity(scope _entity)
 		":rtype: Vector"
 	);
 
+	BaseEntity.def("get_velocity_into",
+		&CBaseEntityWrapper::GetVelocityInto,
+		"Write the entity's velocity into an existing vector.\n\n"
+		":param Vector output: The vector to write to.",
+		args("output")
+	);
+
 	BaseEntity.add_property(
 		"view_offset",
 		&CBaseEntityWrapper::GetViewOffset,
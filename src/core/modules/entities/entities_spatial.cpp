@@ -0,0 +1,425 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2016 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+// Source.Python
+#include "entities_spatial.h"
+#include "entities_entity.h"
+#include "utilities/conversions.h"
+#include "utilities/wrap_macros.h"
+#include "utilities/sp_util.h"
+
+// SDK
+#include "edict.h"
+#include "engine/ICollideable.h"
+
+// Boost.Python
+#include "boost/python/stl_iterator.hpp"
+
+
+//-----------------------------------------------------------------------------
+// External variables.
+//-----------------------------------------------------------------------------
+extern CGlobalVars* gpGlobals;
+
+
+//-----------------------------------------------------------------------------
+// Globals.
+//-----------------------------------------------------------------------------
+CEntitySpatialIndex g_EntitySpatialIndex;
+
+
+//-----------------------------------------------------------------------------
+// Helper functions.
+//-----------------------------------------------------------------------------
+static void GetClassnames(object classnames, std::vector<std::string>& output)
+{
+	if (classnames.is_none())
+		return;
+
+	extract<const char*> classname(classnames);
+	if (classname.check())
+	{
+		output.push_back(classname());
+		return;
+	}
+
+	for (int i=0; i < len(classnames); i++)
+		output.push_back(extract<const char*>(classnames[i])());
+}
+
+static bool MatchesClassname(unsigned int uiIndex, const std::vector<std::string>& classnames)
+{
+	if (classnames.empty())
+		return true;
+
+	CBaseEntity* pEntity;
+	if (!BaseEntityFromIndex(uiIndex, pEntity))
+		return false;
+
+	const char* szClassname = IServerUnknownExt::GetClassname((CBaseEntityWrapper*) pEntity);
+	if (!szClassname)
+		return false;
+
+	for (unsigned int i=0; i < classnames.size(); i++)
+	{
+		if (classnames[i] == szClassname)
+			return true;
+	}
+
+	return false;
+}
+
+
+static bool BoxesOverlap(const Vector& vecMins1, const Vector& vecMaxs1, const Vector& vecMins2, const Vector& vecMaxs2)
+{
+	for (int i=0; i < 3; i++)
+	{
+		if (vecMins1[i] > vecMaxs2[i] || vecMaxs1[i] < vecMins2[i])
+			return false;
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------
+// CEntitySpatialIndex.
+//-----------------------------------------------------------------------------
+CEntitySpatialIndex::CEntitySpatialIndex()
+{
+	m_flCellSize = SPATIAL_DEFAULT_CELL_SIZE;
+	m_iLastTick = -1;
+	m_bTracking = false;
+	m_iIndexedCount = 0;
+	memset(m_Entries, 0, sizeof(m_Entries));
+}
+
+float CEntitySpatialIndex::GetCellSize()
+{
+	return m_flCellSize;
+}
+
+void CEntitySpatialIndex::SetCellSize(float flCellSize)
+{
+	if (flCellSize < 1.0f)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Cell size must be at least 1.")
+
+	m_flCellSize = flCellSize;
+	Clear();
+}
+
+int CEntitySpatialIndex::GetCell(float flValue)
+{
+	// Keep the conversion to int defined for huge and infinite values
+	if (!(flValue > -SPATIAL_MAX_COORD))
+		flValue = -SPATIAL_MAX_COORD;
+	else if (flValue > SPATIAL_MAX_COORD)
+		flValue = SPATIAL_MAX_COORD;
+
+	return (int) floor(flValue / m_flCellSize);
+}
+
+SpatialCellKey CEntitySpatialIndex::GetCellKey(int x, int y, int z)
+{
+	// 21 bits per axis are more than enough for every map size
+	return ((SpatialCellKey) (x & 0x1FFFFF) << 42)
+		| ((SpatialCellKey) (y & 0x1FFFFF) << 21)
+		| (SpatialCellKey) (z & 0x1FFFFF);
+}
+
+void CEntitySpatialIndex::Insert(unsigned int uiIndex, const Vector& vecMins, const Vector& vecMaxs)
+{
+	SpatialEntry_t& entry = m_Entries[uiIndex];
+	entry.m_bIndexed = true;
+	m_Indexed.Set(uiIndex);
+	m_iIndexedCount++;
+	entry.m_vecMins = vecMins;
+	entry.m_vecMaxs = vecMaxs;
+
+	for (int i=0; i < 3; i++)
+	{
+		entry.m_iCellMins[i] = GetCell(vecMins[i]);
+		entry.m_iCellMaxs[i] = GetCell(vecMaxs[i]);
+	}
+
+	long long iCells = (long long) (entry.m_iCellMaxs[0] - entry.m_iCellMins[0] + 1)
+		* (entry.m_iCellMaxs[1] - entry.m_iCellMins[1] + 1)
+		* (entry.m_iCellMaxs[2] - entry.m_iCellMins[2] + 1);
+
+	entry.m_bOversized = iCells > SPATIAL_MAX_ENTITY_CELLS;
+	if (entry.m_bOversized)
+	{
+		m_Oversized.Set(uiIndex);
+		return;
+	}
+
+	for (int x=entry.m_iCellMins[0]; x <= entry.m_iCellMaxs[0]; x++)
+	{
+		for (int y=entry.m_iCellMins[1]; y <= entry.m_iCellMaxs[1]; y++)
+		{
+			for (int z=entry.m_iCellMins[2]; z <= entry.m_iCellMaxs[2]; z++)
+				m_Cells[GetCellKey(x, y, z)].push_back((unsigned short) uiIndex);
+		}
+	}
+}
+
+void CEntitySpatialIndex::Remove(unsigned int uiIndex)
+{
+	SpatialEntry_t& entry = m_Entries[uiIndex];
+	if (!entry.m_bIndexed)
+		return;
+
+	entry.m_bIndexed = false;
+	m_Indexed.Clear(uiIndex);
+	m_iIndexedCount--;
+
+	if (entry.m_bOversized)
+	{
+		m_Oversized.Clear(uiIndex);
+		return;
+	}
+
+	for (int x=entry.m_iCellMins[0]; x <= entry.m_iCellMaxs[0]; x++)
+	{
+		for (int y=entry.m_iCellMins[1]; y <= entry.m_iCellMaxs[1]; y++)
+		{
+			for (int z=entry.m_iCellMins[2]; z <= entry.m_iCellMaxs[2]; z++)
+			{
+				SpatialCellMap::iterator it = m_Cells.find(GetCellKey(x, y, z));
+				if (it == m_Cells.end())
+					continue;
+
+				// The order within a cell doesn't matter
+				std::vector<unsigned short>& cell = it->second;
+				for (unsigned int i=0; i < cell.size(); i++)
+				{
+					if (cell[i] != uiIndex)
+						continue;
+
+					cell[i] = cell.back();
+					cell.pop_back();
+					break;
+				}
+
+				if (cell.empty())
+					m_Cells.erase(it);
+			}
+		}
+	}
+}
+
+void CEntitySpatialIndex::Update()
+{
+	if (m_iLastTick == gpGlobals->tickcount)
+		return;
+
+	m_iLastTick = gpGlobals->tickcount;
+
+	// Entities that have been created before the index was cleared or
+	// before the plugin was loaded are only found by scanning all edicts
+	if (!m_bTracking)
+	{
+		m_Tracked.ClearAll();
+		for (int i=1; i < gpGlobals->maxEntities && i < MAX_EDICTS; i++)
+		{
+			edict_t* pEdict;
+			if (EdictFromIndex(i, pEdict))
+				m_Tracked.Set(i);
+		}
+
+		m_bTracking = true;
+	}
+
+	for (int i=m_Tracked.FindNextSetBit(0); i != -1; i=m_Tracked.FindNextSetBit(i + 1))
+	{
+		CBaseEntity* pEntity;
+		ICollideable* pCollideable = NULL;
+		if (BaseEntityFromIndex(i, pEntity))
+			pCollideable = ((CBaseEntityWrapper*) pEntity)->GetCollideable();
+
+		if (!pCollideable)
+		{
+			Remove(i);
+			continue;
+		}
+
+		Vector vecMins, vecMaxs;
+		pCollideable->WorldSpaceSurroundingBounds(&vecMins, &vecMaxs);
+
+		// Only re-insert entities that have moved or changed their size
+		SpatialEntry_t& entry = m_Entries[i];
+		if (entry.m_bIndexed && entry.m_vecMins == vecMins && entry.m_vecMaxs == vecMaxs)
+			continue;
+
+		Remove(i);
+		Insert(i, vecMins, vecMaxs);
+	}
+}
+
+void CEntitySpatialIndex::Clear()
+{
+	m_Cells.clear();
+	m_Indexed.ClearAll();
+	m_iIndexedCount = 0;
+	m_Oversized.ClearAll();
+	memset(m_Entries, 0, sizeof(m_Entries));
+	m_iLastTick = -1;
+	m_bTracking = false;
+	m_Tracked.ClearAll();
+}
+
+void CEntitySpatialIndex::OnEntityCreated(unsigned int uiIndex)
+{
+	if (uiIndex < MAX_EDICTS)
+		m_Tracked.Set(uiIndex);
+}
+
+void CEntitySpatialIndex::OnEntityDeleted(unsigned int uiIndex)
+{
+	if (uiIndex >= MAX_EDICTS)
+		return;
+
+	m_Tracked.Clear(uiIndex);
+	Remove(uiIndex);
+}
+
+object CEntitySpatialIndex::EntitiesInSphere(const Vector& vecCenter, float flRadius, object classnames)
+{
+	if (!vecCenter.IsValid() || !IsFinite(flRadius))
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Center and radius must be finite.")
+
+	if (flRadius < 0)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Radius must not be negative.")
+
+	Vector vecExtent(flRadius, flRadius, flRadius);
+	return Query(vecCenter - vecExtent, vecCenter + vecExtent, &vecCenter, flRadius, classnames);
+}
+
+object CEntitySpatialIndex::EntitiesInBox(const Vector& vecMins, const Vector& vecMaxs, object classnames)
+{
+	if (!vecMins.IsValid() || !vecMaxs.IsValid())
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Box corners must be finite.")
+
+	return Query(vecMins, vecMaxs, NULL, 0, classnames);
+}
+
+boost::shared_ptr<CVectorArray> CEntitySpatialIndex::GetOrigins(object indexes)
+{
+	stl_input_iterator<unsigned int> it(indexes), end;
+	boost::shared_ptr<CVectorArray> pOrigins(new CVectorArray());
+	for (; it != end; ++it)
+	{
+		CBaseEntity* pEntity;
+		ICollideable* pCollideable = NULL;
+		if (BaseEntityFromIndex(*it, pEntity))
+			pCollideable = ((CBaseEntityWrapper*) pEntity)->GetCollideable();
+
+		if (!pCollideable)
+			BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Invalid entity index: %u.", *it)
+
+		pOrigins->Append(pCollideable->GetCollisionOrigin());
+	}
+
+	return pOrigins;
+}
+
+object CEntitySpatialIndex::Query(const Vector& vecMins, const Vector& vecMaxs, const Vector* pCenter,
+	float flRadius, object classnames)
+{
+	std::vector<std::string> vecClassnames;
+	GetClassnames(classnames, vecClassnames);
+
+	Update();
+
+	int iMins[3], iMaxs[3];
+	long long iCells = 1;
+	for (int i=0; i < 3; i++)
+	{
+		iMins[i] = GetCell(vecMins[i]);
+		iMaxs[i] = GetCell(vecMaxs[i]);
+		iCells *= iMaxs[i] >= iMins[i] ? iMaxs[i] - iMins[i] + 1 : 0;
+	}
+
+	// Testing every indexed entity is cheaper than looking up more cells
+	// than there are entities
+	CBitVec<MAX_EDICTS> candidates;
+	if (iCells > m_iIndexedCount)
+		candidates = m_Indexed;
+	else
+		candidates = m_Oversized;
+
+	// Collect the candidates of all overlapped cells only once
+	for (int x=iMins[0]; iCells <= m_iIndexedCount && x <= iMaxs[0]; x++)
+	{
+		for (int y=iMins[1]; y <= iMaxs[1]; y++)
+		{
+			for (int z=iMins[2]; z <= iMaxs[2]; z++)
+			{
+				SpatialCellMap::const_iterator it = m_Cells.find(GetCellKey(x, y, z));
+				if (it == m_Cells.end())
+					continue;
+
+				const std::vector<unsigned short>& cell = it->second;
+				for (unsigned int i=0; i < cell.size(); i++)
+					candidates.Set(cell[i]);
+			}
+		}
+	}
+
+	std::vector<unsigned short> result;
+	for (int i=candidates.FindNextSetBit(0); i != -1; i=candidates.FindNextSetBit(i + 1))
+	{
+		const SpatialEntry_t& entry = m_Entries[i];
+		if (!BoxesOverlap(vecMins, vecMaxs, entry.m_vecMins, entry.m_vecMaxs))
+			continue;
+
+		// Test the closest point of the bounds for spheres
+		if (pCenter)
+		{
+			float flDistSqr = 0;
+			for (int j=0; j < 3; j++)
+			{
+				float flValue = (*pCenter)[j];
+				if (flValue < entry.m_vecMins[j])
+					flDistSqr += (entry.m_vecMins[j] - flValue) * (entry.m_vecMins[j] - flValue);
+				else if (flValue > entry.m_vecMaxs[j])
+					flDistSqr += (flValue - entry.m_vecMaxs[j]) * (flValue - entry.m_vecMaxs[j]);
+			}
+
+			if (flDistSqr > flRadius * flRadius)
+				continue;
+		}
+
+		if (MatchesClassname(i, vecClassnames))
+			result.push_back((unsigned short) i);
+	}
+
+	return MakeArray("H", result);
+}
@@ -0,0 +1,136 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2016 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+#ifndef _ENTITIES_SPATIAL_H
+#define _ENTITIES_SPATIAL_H
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+// C++
+#include <vector>
+#include <string>
+
+// Boost
+#include "boost/unordered_map.hpp"
+
+// Boost.Python
+#include "boost/python.hpp"
+using namespace boost::python;
+
+// SDK
+#include "bitvec.h"
+#include "const.h"
+#include "mathlib/vector.h"
+
+// Source.Python
+#include "modules/mathlib/mathlib_vector_array.h"
+
+
+//-----------------------------------------------------------------------------
+// Constants.
+//-----------------------------------------------------------------------------
+#define SPATIAL_DEFAULT_CELL_SIZE 512.0f
+
+// Entities that overlap more cells than this are tested on every query
+#define SPATIAL_MAX_ENTITY_CELLS 64
+
+// Coordinates are clamped to this range before they are mapped to cells
+#define SPATIAL_MAX_COORD 65536.0f
+
+typedef unsigned long long SpatialCellKey;
+typedef boost::unordered_map<SpatialCellKey, std::vector<unsigned short> > SpatialCellMap;
+
+
+//-----------------------------------------------------------------------------
+// Indexed bounds of an entity.
+//-----------------------------------------------------------------------------
+struct SpatialEntry_t
+{
+	bool	m_bIndexed;
+	bool	m_bOversized;
+	Vector	m_vecMins;
+	Vector	m_vecMaxs;
+	int		m_iCellMins[3];
+	int		m_iCellMaxs[3];
+};
+
+
+//-----------------------------------------------------------------------------
+// Uniform grid of networked entity bounds.
+//
+// The grid is built on the first query, which also scans all edicts once to
+// find the existing entities. Afterwards, entities are tracked through the
+// create and delete notifications of the server plugin. Before the first
+// query of a tick, the bounds of the tracked entities are compared with the
+// indexed ones and only moved entities are re-inserted. Deleted entities are
+// removed immediately.
+//-----------------------------------------------------------------------------
+class CEntitySpatialIndex
+{
+public:
+	CEntitySpatialIndex();
+
+	object EntitiesInSphere(const Vector& vecCenter, float flRadius, object classnames);
+	object EntitiesInBox(const Vector& vecMins, const Vector& vecMaxs, object classnames);
+
+	boost::shared_ptr<CVectorArray> GetOrigins(object indexes);
+
+	float GetCellSize();
+	void SetCellSize(float flCellSize);
+
+	void Update();
+	void Clear();
+
+	void OnEntityCreated(unsigned int uiIndex);
+	void OnEntityDeleted(unsigned int uiIndex);
+
+private:
+	void Insert(unsigned int uiIndex, const Vector& vecMins, const Vector& vecMaxs);
+	void Remove(unsigned int uiIndex);
+
+	int GetCell(float flValue);
+	SpatialCellKey GetCellKey(int x, int y, int z);
+
+	object Query(const Vector& vecMins, const Vector& vecMaxs, const Vector* pCenter, float flRadius, object classnames);
+
+private:
+	float					m_flCellSize;
+	int						m_iLastTick;
+	bool					m_bTracking;
+	CBitVec<MAX_EDICTS>		m_Tracked;
+	SpatialCellMap			m_Cells;
+	SpatialEntry_t			m_Entries[MAX_EDICTS];
+	CBitVec<MAX_EDICTS>		m_Indexed;
+	int						m_iIndexedCount;
+	CBitVec<MAX_EDICTS>		m_Oversized;
+};
+
+extern CEntitySpatialIndex g_EntitySpatialIndex;
+
+
+#endif // _ENTITIES_SPATIAL_H
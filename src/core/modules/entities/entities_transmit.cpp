@@ -0,0 +1,468 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2016 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+// Source.Python
+#include "entities_transmit.h"
+#include "entities_entity.h"
+#include "utilities/conversions.h"
+#include "utilities/wrap_macros.h"
+#include "modules/players/players_state.h"
+#include "modules/engines/engines_visibility.h"
+
+// SDK
+#include "edict.h"
+
+// C++
+#include <algorithm>
+
+
+//-----------------------------------------------------------------------------
+// External variables.
+//-----------------------------------------------------------------------------
+extern CGlobalVars* gpGlobals;
+
+
+//-----------------------------------------------------------------------------
+// Globals.
+//-----------------------------------------------------------------------------
+CTransmitManager g_TransmitManager;
+
+
+//-----------------------------------------------------------------------------
+// CTransmitRules.
+//-----------------------------------------------------------------------------
+CTransmitRules::CTransmitRules()
+{
+	m_iHiddenCount = 0;
+	m_bHasTeamRules = false;
+	memset(m_uiTeamRules, 0, sizeof(m_uiTeamRules));
+}
+
+void CTransmitRules::CheckEntityIndex(unsigned int uiEntity)
+{
+	if (uiEntity == WORLD_ENTITY_INDEX || uiEntity >= MAX_EDICTS)
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid entity index: %u.", uiEntity)
+}
+
+void CTransmitRules::CheckPlayerIndex(unsigned int uiPlayer)
+{
+	if (uiPlayer == WORLD_ENTITY_INDEX || uiPlayer > ABSOLUTE_PLAYER_LIMIT)
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid player index: %u.", uiPlayer)
+}
+
+void CTransmitRules::Hide(unsigned int uiEntity, unsigned int uiPlayer)
+{
+	CheckEntityIndex(uiEntity);
+	CheckPlayerIndex(uiPlayer);
+
+	if (m_Hidden[uiPlayer].IsBitSet(uiEntity))
+		return;
+
+	m_Hidden[uiPlayer].Set(uiEntity);
+	m_iHiddenCount++;
+}
+
+void CTransmitRules::Show(unsigned int uiEntity, unsigned int uiPlayer)
+{
+	CheckEntityIndex(uiEntity);
+	CheckPlayerIndex(uiPlayer);
+
+	if (!m_Hidden[uiPlayer].IsBitSet(uiEntity))
+		return;
+
+	m_Hidden[uiPlayer].Clear(uiEntity);
+	m_iHiddenCount--;
+}
+
+void CTransmitRules::HideFromAll(unsigned int uiEntity)
+{
+	CheckEntityIndex(uiEntity);
+	for (unsigned int i=1; i <= ABSOLUTE_PLAYER_LIMIT; i++)
+		Hide(uiEntity, i);
+}
+
+void CTransmitRules::Reset(unsigned int uiEntity)
+{
+	CheckEntityIndex(uiEntity);
+	for (unsigned int i=1; i <= ABSOLUTE_PLAYER_LIMIT; i++)
+		Show(uiEntity, i);
+}
+
+bool CTransmitRules::IsHidden(unsigned int uiEntity, unsigned int uiPlayer)
+{
+	CheckEntityIndex(uiEntity);
+	CheckPlayerIndex(uiPlayer);
+	return m_Hidden[uiPlayer].IsBitSet(uiEntity) || m_ClassnameHidden.IsBitSet(uiEntity);
+}
+
+void CTransmitRules::SetTeamHidden(int iTeam, int iObserverTeam, bool bHidden)
+{
+	if (iTeam < 0 || iTeam >= TRANSMIT_TEAM_LIMIT || iObserverTeam < 0 || iObserverTeam >= TRANSMIT_TEAM_LIMIT)
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid team index.")
+
+	if (bHidden)
+		m_uiTeamRules[iObserverTeam] |= (1u << iTeam);
+	else
+		m_uiTeamRules[iObserverTeam] &= ~(1u << iTeam);
+
+	m_bHasTeamRules = false;
+	for (int i=0; i < TRANSMIT_TEAM_LIMIT; i++)
+	{
+		if (m_uiTeamRules[i])
+		{
+			m_bHasTeamRules = true;
+			break;
+		}
+	}
+}
+
+bool CTransmitRules::IsTeamHidden(int iTeam, int iObserverTeam)
+{
+	if (iTeam < 0 || iTeam >= TRANSMIT_TEAM_LIMIT || iObserverTeam < 0 || iObserverTeam >= TRANSMIT_TEAM_LIMIT)
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid team index.")
+
+	return (m_uiTeamRules[iObserverTeam] & (1u << iTeam)) != 0;
+}
+
+void CTransmitRules::HideClassname(const char* szClassname)
+{
+	if (m_Classnames.insert(szClassname).second)
+		UpdateClassnameBits();
+}
+
+void CTransmitRules::ShowClassname(const char* szClassname)
+{
+	if (m_Classnames.erase(szClassname))
+		UpdateClassnameBits();
+}
+
+bool CTransmitRules::IsClassnameHidden(const char* szClassname)
+{
+	return m_Classnames.find(szClassname) != m_Classnames.end();
+}
+
+void CTransmitRules::UpdateClassnameBits()
+{
+	m_ClassnameHidden.ClearAll();
+	if (m_Classnames.empty())
+		return;
+
+	// Classnames are only compared when the rules change or an entity spawns
+	CBaseEntity* pEntity = (CBaseEntity*) servertools->FirstEntity();
+	while (pEntity)
+	{
+		unsigned int uiIndex;
+		CBaseEntityWrapper* pWrapper = (CBaseEntityWrapper*) pEntity;
+		if (IndexFromBaseEntity(pEntity, uiIndex) && uiIndex != WORLD_ENTITY_INDEX && !pWrapper->IsPlayer())
+			OnEntitySpawned(uiIndex, IServerUnknownExt::GetClassname(pWrapper));
+
+		pEntity = (CBaseEntity*) servertools->NextEntity(pEntity);
+	}
+}
+
+void CTransmitRules::Clear()
+{
+	for (int i=0; i <= ABSOLUTE_PLAYER_LIMIT; i++)
+		m_Hidden[i].ClearAll();
+
+	m_iHiddenCount = 0;
+	memset(m_uiTeamRules, 0, sizeof(m_uiTeamRules));
+	m_bHasTeamRules = false;
+	m_Classnames.clear();
+	m_ClassnameHidden.ClearAll();
+}
+
+void CTransmitRules::OnEntitySpawned(unsigned int uiIndex, const char* szClassname)
+{
+	if (szClassname && IsClassnameHidden(szClassname))
+		m_ClassnameHidden.Set(uiIndex);
+}
+
+void CTransmitRules::OnEntityDeleted(unsigned int uiIndex)
+{
+	// The index might be reused by another entity
+	for (int i=0; i <= ABSOLUTE_PLAYER_LIMIT; i++)
+	{
+		if (!m_Hidden[i].IsBitSet(uiIndex))
+			continue;
+
+		m_Hidden[i].Clear(uiIndex);
+		m_iHiddenCount--;
+	}
+
+	m_ClassnameHidden.Clear(uiIndex);
+}
+
+void CTransmitRules::OnClientDisconnect(unsigned int uiIndex)
+{
+	// Don't let the next player in this slot inherit the rules
+	for (int i=0; i < m_Hidden[uiIndex].GetNumBits(); i++)
+	{
+		if (m_Hidden[uiIndex].IsBitSet(i))
+			m_iHiddenCount--;
+	}
+
+	m_Hidden[uiIndex].ClearAll();
+}
+
+bool CTransmitRules::HasRules()
+{
+	return m_iHiddenCount > 0 || m_bHasTeamRules || !m_Classnames.empty();
+}
+
+bool CTransmitRules::HasTeamRules()
+{
+	return m_bHasTeamRules;
+}
+
+void CTransmitRules::AddHidden(TransmitBits& hidden, unsigned int uiPlayer)
+{
+	uint32* pHidden = hidden.Base();
+	const uint32* pPlayerHidden = m_Hidden[uiPlayer].Base();
+	const uint32* pClassnameHidden = m_ClassnameHidden.Base();
+	for (int i=0; i < hidden.GetNumDWords(); i++)
+		pHidden[i] |= pPlayerHidden[i] | pClassnameHidden[i];
+}
+
+unsigned int CTransmitRules::GetTeamRules(int iObserverTeam)
+{
+	if (iObserverTeam < 0 || iObserverTeam >= TRANSMIT_TEAM_LIMIT)
+		return 0;
+
+	return m_uiTeamRules[iObserverTeam];
+}
+
+
+//-----------------------------------------------------------------------------
+// CTransmitRules extension class.
+//-----------------------------------------------------------------------------
+boost::shared_ptr<CTransmitRules> TransmitRulesExt::__init__()
+{
+	CTransmitRules* pRules = new CTransmitRules;
+	g_TransmitManager.AddRules(pRules);
+	return boost::shared_ptr<CTransmitRules>(pRules, &Deleter);
+}
+
+void TransmitRulesExt::Deleter(CTransmitRules* pRules)
+{
+	g_TransmitManager.RemoveRules(pRules);
+	delete pRules;
+}
+
+
+//-----------------------------------------------------------------------------
+// CTransmitManager.
+//-----------------------------------------------------------------------------
+CTransmitManager::CTransmitManager()
+{
+	m_bHideOwnedEntities = true;
+	m_bUseVisibility = false;
+}
+
+void CTransmitManager::Initialize(CFunction* pCheckTransmit)
+{
+	if (!pCheckTransmit->IsHookable())
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Function is not hookable.")
+
+	CHook* pHook = GetHookManager()->FindHook((void*) pCheckTransmit->m_ulAddr);
+	if (!pHook)
+	{
+		pHook = GetHookManager()->HookFunction((void*) pCheckTransmit->m_ulAddr, pCheckTransmit->m_pCallingConvention);
+		if (!pHook)
+			BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Could not create a hook.")
+	}
+
+	// It won't be added twice if the module has been reloaded
+	pHook->AddCallback(HOOKTYPE_POST, (HookHandlerFn*) (void*) &PostCheckTransmit);
+}
+
+void CTransmitManager::AddRules(CTransmitRules* pRules)
+{
+	m_RuleSets.push_back(pRules);
+}
+
+void CTransmitManager::RemoveRules(CTransmitRules* pRules)
+{
+	std::vector<CTransmitRules*>::iterator it = std::find(m_RuleSets.begin(), m_RuleSets.end(), pRules);
+	if (it != m_RuleSets.end())
+		m_RuleSets.erase(it);
+}
+
+void CTransmitManager::OnEntitySpawned(CBaseEntity* pEntity)
+{
+	unsigned int uiIndex;
+	if (!IndexFromBaseEntity(pEntity, uiIndex) || uiIndex == WORLD_ENTITY_INDEX)
+		return;
+
+	// Players are never hidden by their classname
+	CBaseEntityWrapper* pWrapper = (CBaseEntityWrapper*) pEntity;
+	if (pWrapper->IsPlayer())
+		return;
+
+	const char* szClassname = IServerUnknownExt::GetClassname(pWrapper);
+	CTransmitRules::OnEntitySpawned(uiIndex, szClassname);
+	for (std::vector<CTransmitRules*>::iterator it = m_RuleSets.begin(); it != m_RuleSets.end(); ++it)
+		(*it)->OnEntitySpawned(uiIndex, szClassname);
+}
+
+void CTransmitManager::OnEntityDeleted(unsigned int uiIndex)
+{
+	if (uiIndex >= MAX_EDICTS)
+		return;
+
+	CTransmitRules::OnEntityDeleted(uiIndex);
+	for (std::vector<CTransmitRules*>::iterator it = m_RuleSets.begin(); it != m_RuleSets.end(); ++it)
+		(*it)->OnEntityDeleted(uiIndex);
+}
+
+void CTransmitManager::OnClientDisconnect(unsigned int uiIndex)
+{
+	if (uiIndex == WORLD_ENTITY_INDEX || uiIndex > ABSOLUTE_PLAYER_LIMIT)
+		return;
+
+	CTransmitRules::OnClientDisconnect(uiIndex);
+	for (std::vector<CTransmitRules*>::iterator it = m_RuleSets.begin(); it != m_RuleSets.end(); ++it)
+		(*it)->OnClientDisconnect(uiIndex);
+}
+
+bool CTransmitManager::HasRules()
+{
+	if (m_bUseVisibility || CTransmitRules::HasRules())
+		return true;
+
+	for (std::vector<CTransmitRules*>::iterator it = m_RuleSets.begin(); it != m_RuleSets.end(); ++it)
+	{
+		if ((*it)->HasRules())
+			return true;
+	}
+
+	return false;
+}
+
+bool CTransmitManager::PostCheckTransmit(HookType_t eHookType, CHook* pHook)
+{
+	if (!g_TransmitManager.HasRules())
+		return false;
+
+	g_TransmitManager.Apply(
+		pHook->GetArgument<CCheckTransmitInfo*>(1),
+		pHook->GetArgument<const unsigned short*>(2),
+		pHook->GetArgument<int>(3));
+
+	return false;
+}
+
+void CTransmitManager::Apply(CCheckTransmitInfo* pInfo, const unsigned short* pEdictIndices, int nEdicts)
+{
+	unsigned int uiPlayer;
+	if (!IndexFromEdict(pInfo->m_pClientEnt, uiPlayer) || uiPlayer == WORLD_ENTITY_INDEX
+		|| uiPlayer > (unsigned int) gpGlobals->maxClients)
+		return;
+
+	// Combine the rules of all rule sets for this player into a single mask
+	TransmitBits hidden;
+	bool bHasTeamRules = HasTeamRules();
+	AddHidden(hidden, uiPlayer);
+	for (std::vector<CTransmitRules*>::iterator it = m_RuleSets.begin(); it != m_RuleSets.end(); ++it)
+	{
+		(*it)->AddHidden(hidden, uiPlayer);
+		bHasTeamRules = bHasTeamRules || (*it)->HasTeamRules();
+	}
+
+	// Team and visibility rules only apply to players
+	if (bHasTeamRules || m_bUseVisibility)
+	{
+		int iObserverTeam = g_PlayerStateTable.GetTeam(uiPlayer);
+		unsigned int uiTeams = GetTeamRules(iObserverTeam);
+		for (std::vector<CTransmitRules*>::iterator it = m_RuleSets.begin(); it != m_RuleSets.end(); ++it)
+			uiTeams |= (*it)->GetTeamRules(iObserverTeam);
+
+		for (unsigned int i=1; i <= (unsigned int) gpGlobals->maxClients; i++)
+		{
+			if (i == uiPlayer || !g_PlayerStateTable.IsConnected(i))
+				continue;
+
+			int iTeam = g_PlayerStateTable.GetTeam(i);
+			if ((iTeam >= 0 && iTeam < TRANSMIT_TEAM_LIMIT && (uiTeams & (1u << iTeam)))
+				|| (m_bUseVisibility && !g_VisibilityMatrix.IsVisible(uiPlayer, i)))
+			{
+				hidden.Set(i);
+			}
+		}
+	}
+
+	// Players always receive the world and themselves
+	hidden.Clear(WORLD_ENTITY_INDEX);
+	hidden.Clear(uiPlayer);
+
+	bool bPlayerHidden = false;
+	for (unsigned int i=1; i <= (unsigned int) gpGlobals->maxClients; i++)
+	{
+		if (hidden.IsBitSet(i))
+		{
+			bPlayerHidden = true;
+			break;
+		}
+	}
+
+	// Hide weapons and wearables of hidden players
+	if (bPlayerHidden && m_bHideOwnedEntities)
+	{
+		static int offset = -1;
+		for (int i=0; i < nEdicts; i++)
+		{
+			unsigned int uiIndex = pEdictIndices[i];
+			if (uiIndex <= (unsigned int) gpGlobals->maxClients || hidden.IsBitSet(uiIndex)
+				|| !pInfo->m_pTransmitEdict->IsBitSet(uiIndex))
+				continue;
+
+			CBaseEntity* pBaseEntity;
+			if (!BaseEntityFromIndex(uiIndex, pBaseEntity))
+				continue;
+
+			CBaseEntityWrapper* pEntity = (CBaseEntityWrapper*) pBaseEntity;
+			if (offset == -1)
+				offset = pEntity->FindDatamapPropertyOffset("m_hOwnerEntity");
+
+			unsigned int uiOwner;
+			if (IndexFromIntHandle(pEntity->GetDatamapPropertyByOffset<int>(offset), uiOwner)
+				&& uiOwner != WORLD_ENTITY_INDEX && uiOwner <= (unsigned int) gpGlobals->maxClients
+				&& hidden.IsBitSet(uiOwner))
+			{
+				hidden.Set(uiIndex);
+			}
+		}
+	}
+
+	const uint32* pHidden = hidden.Base();
+	uint32* pTransmit = pInfo->m_pTransmitEdict->Base();
+	for (int i=0; i < hidden.GetNumDWords(); i++)
+		pTransmit[i] &= ~pHidden[i];
+}
@@ -0,0 +1,184 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2016 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+#ifndef _ENTITIES_TRANSMIT_H
+#define _ENTITIES_TRANSMIT_H
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+// C++
+#include <string>
+#include <vector>
+
+// DynamicHooks
+#include "hook.h"
+
+// Boost
+#include "boost/unordered_set.hpp"
+
+// Boost.Python
+#include "boost/python.hpp"
+using namespace boost::python;
+
+// SDK
+#include "bitvec.h"
+#include "const.h"
+#include "iservernetworkable.h"
+
+// Source.Python
+#include "modules/memory/memory_function.h"
+
+
+//-----------------------------------------------------------------------------
+// Constants.
+//-----------------------------------------------------------------------------
+// Team rules are stored as a bit mask per observing team
+#define TRANSMIT_TEAM_LIMIT 32
+
+typedef CBitVec<MAX_EDICTS> TransmitBits;
+typedef boost::unordered_set<std::string> TransmitClassnameSet;
+
+
+//-----------------------------------------------------------------------------
+// A set of transmit rules.
+//
+// Every TransmitRules instance owns its own set, so removing the rules of one
+// plugin doesn't affect the rules of another one. The transmit manager ORs all
+// sets together.
+//-----------------------------------------------------------------------------
+class CBaseEntity;
+
+class CTransmitRules
+{
+public:
+	CTransmitRules();
+
+	// Per entity and player rules
+	void Hide(unsigned int uiEntity, unsigned int uiPlayer);
+	void Show(unsigned int uiEntity, unsigned int uiPlayer);
+	void HideFromAll(unsigned int uiEntity);
+	void Reset(unsigned int uiEntity);
+	bool IsHidden(unsigned int uiEntity, unsigned int uiPlayer);
+
+	// Team rules
+	void SetTeamHidden(int iTeam, int iObserverTeam, bool bHidden);
+	bool IsTeamHidden(int iTeam, int iObserverTeam);
+
+	// Classname rules
+	void HideClassname(const char* szClassname);
+	void ShowClassname(const char* szClassname);
+	bool IsClassnameHidden(const char* szClassname);
+
+	void Clear();
+
+	// Entity and client notifications
+	void OnEntitySpawned(unsigned int uiIndex, const char* szClassname);
+	void OnEntityDeleted(unsigned int uiIndex);
+	void OnClientDisconnect(unsigned int uiIndex);
+
+	// Used by CTransmitManager::Apply()
+	bool HasRules();
+	bool HasTeamRules();
+	void AddHidden(TransmitBits& hidden, unsigned int uiPlayer);
+	unsigned int GetTeamRules(int iObserverTeam);
+
+private:
+	void CheckEntityIndex(unsigned int uiEntity);
+	void CheckPlayerIndex(unsigned int uiPlayer);
+	void UpdateClassnameBits();
+
+private:
+	// Entities that are hidden from a player, indexed by the player index
+	TransmitBits			m_Hidden[ABSOLUTE_PLAYER_LIMIT + 1];
+	int						m_iHiddenCount;
+
+	// Bit n of m_uiTeamRules[t] hides players of team n from players of team t
+	unsigned int			m_uiTeamRules[TRANSMIT_TEAM_LIMIT];
+	bool					m_bHasTeamRules;
+
+	TransmitClassnameSet	m_Classnames;
+	TransmitBits			m_ClassnameHidden;
+};
+
+
+//-----------------------------------------------------------------------------
+// Native transmit rules that are applied in a single CheckTransmit hook.
+//
+// Python only edits the rules. The per snapshot work is done after the game
+// has built the transmit list of a client, by removing every hidden entity
+// from it. The manager's own rules are combined with all other rule sets.
+//-----------------------------------------------------------------------------
+class CTransmitManager : public CTransmitRules
+{
+public:
+	CTransmitManager();
+
+	void Initialize(CFunction* pCheckTransmit);
+
+	// Rule sets owned by TransmitRules instances
+	void AddRules(CTransmitRules* pRules);
+	void RemoveRules(CTransmitRules* pRules);
+
+	// Entity and client notifications
+	void OnEntitySpawned(CBaseEntity* pEntity);
+	void OnEntityDeleted(unsigned int uiIndex);
+	void OnClientDisconnect(unsigned int uiIndex);
+
+	// Hook handler
+	static bool PostCheckTransmit(HookType_t eHookType, CHook* pHook);
+
+public:
+	// If True, entities owned by a hidden player are hidden as well
+	bool					m_bHideOwnedEntities;
+
+	// If True, players that are not visible in the visibility matrix are hidden
+	bool					m_bUseVisibility;
+
+private:
+	bool HasRules();
+	void Apply(CCheckTransmitInfo* pInfo, const unsigned short* pEdictIndices, int nEdicts);
+
+private:
+	std::vector<CTransmitRules*>	m_RuleSets;
+};
+
+extern CTransmitManager g_TransmitManager;
+
+
+//-----------------------------------------------------------------------------
+// CTransmitRules extension class.
+//-----------------------------------------------------------------------------
+class TransmitRulesExt
+{
+public:
+	static boost::shared_ptr<CTransmitRules> __init__();
+	static void Deleter(CTransmitRules* pRules);
+};
+
+
+#endif // _ENTITIES_TRANSMIT_H
@@ -38,6 +38,8 @@
 #include "export_main.h"
 #include "entities.h"
 #include "entities_generator.h"
+#include "entities_transmit.h"
+#include "entities_spatial.h"
 
 #include ENGINE_INCLUDE_PATH(entities_wrap.h)
 
@@ -56,6 +58,9 @@ void export_take_damage_info(scope);
 void export_global_entity_list(scope);
 void export_entity_listener(scope);
 void export_check_transmit_info(scope);
+void export_transmit_rules(scope);
+void export_transmit_manager(scope);
+void export_entity_spatial_index(scope);
 void export_baseentity_generator(scope);
 void export_server_class_generator(scope);
 void export_collideable(scope);
@@ -80,6 +85,9 @@ DECLARE_SP_MODULE(_entities)
 	export_global_entity_list(_entities);
 	export_entity_listener(_entities);
 	export_check_transmit_info(_entities);
+	export_transmit_rules(_entities);
+	export_transmit_manager(_entities);
+	export_entity_spatial_index(_entities);
 	export_baseentity_generator(_entities);
 	export_server_class_generator(_entities);
 	export_collideable(_entities);
@@ -578,6 +586,221 @@ void export_check_transmit_info(scope _entities)
 }
 
 
+//-----------------------------------------------------------------------------
+// Exports CTransmitRules.
+//-----------------------------------------------------------------------------
+void export_transmit_rules(scope _entities)
+{
+	class_<CTransmitRules, boost::shared_ptr<CTransmitRules>, boost::noncopyable> TransmitRules("_TransmitRules", no_init);
+
+	TransmitRules.def(
+		"__init__",
+		make_constructor(&TransmitRulesExt::__init__),
+		"Create a new rule set. Its rules are combined with the rules of all other rule sets.");
+
+	TransmitRules.def(
+		"hide",
+		&CTransmitRules::Hide,
+		"Hide an entity from a player.\n\n"
+		":param int entity:\n"
+		"    The index of the entity to hide.\n"
+		":param int player:\n"
+		"    The index of the player.",
+		args("entity", "player"));
+
+	TransmitRules.def(
+		"show",
+		&CTransmitRules::Show,
+		"Remove the rule that hides an entity from a player.\n\n"
+		":param int entity:\n"
+		"    The index of the entity.\n"
+		":param int player:\n"
+		"    The index of the player.",
+		args("entity", "player"));
+
+	TransmitRules.def(
+		"hide_from_all",
+		&CTransmitRules::HideFromAll,
+		"Hide an entity from all players.\n\n"
+		":param int entity:\n"
+		"    The index of the entity to hide.",
+		args("entity"));
+
+	TransmitRules.def(
+		"reset",
+		&CTransmitRules::Reset,
+		"Remove all rules that hide an entity from a player.\n\n"
+		":param int entity:\n"
+		"    The index of the entity.",
+		args("entity"));
+
+	TransmitRules.def(
+		"is_hidden",
+		&CTransmitRules::IsHidden,
+		"Return whether an entity is hidden from a player by an entity or classname rule.\n\n"
+		":param int entity:\n"
+		"    The index of the entity.\n"
+		":param int player:\n"
+		"    The index of the player.\n"
+		":rtype: bool",
+		args("entity", "player"));
+
+	TransmitRules.def(
+		"set_team_hidden",
+		&CTransmitRules::SetTeamHidden,
+		"Hide or show the players of a team to the players of another team.\n\n"
+		":param int team:\n"
+		"    The team of the players to hide.\n"
+		":param int observer_team:\n"
+		"    The team of the players they are hidden from.\n"
+		":param bool hidden:\n"
+		"    Whether the players are hidden.",
+		args("team", "observer_team", "hidden"));
+
+	TransmitRules.def(
+		"is_team_hidden",
+		&CTransmitRules::IsTeamHidden,
+		"Return whether the players of a team are hidden from another team.\n\n"
+		":param int team:\n"
+		"    The team of the hidden players.\n"
+		":param int observer_team:\n"
+		"    The team of the observing players.\n"
+		":rtype: bool",
+		args("team", "observer_team"));
+
+	TransmitRules.def(
+		"hide_classname",
+		&CTransmitRules::HideClassname,
+		"Hide all entities with the given classname from all players.\n\n"
+		":param str classname:\n"
+		"    The classname of the entities to hide.",
+		args("classname"));
+
+	TransmitRules.def(
+		"show_classname",
+		&CTransmitRules::ShowClassname,
+		"Remove the rule that hides all entities with the given classname.\n\n"
+		":param str classname:\n"
+		"    The classname of the entities.",
+		args("classname"));
+
+	TransmitRules.def(
+		"is_classname_hidden",
+		&CTransmitRules::IsClassnameHidden,
+		"Return whether entities with the given classname are hidden.\n\n"
+		":param str classname:\n"
+		"    The classname to check.\n"
+		":rtype: bool",
+		args("classname"));
+
+	TransmitRules.def(
+		"clear",
+		&CTransmitRules::Clear,
+		"Remove all rules of this rule set.");
+
+}
+
+
+//-----------------------------------------------------------------------------
+// Exports CTransmitManager.
+//-----------------------------------------------------------------------------
+void export_transmit_manager(scope _entities)
+{
+	class_<CTransmitManager, bases<CTransmitRules>, boost::noncopyable> TransmitManager("TransmitManager", no_init);
+
+	TransmitManager.def(
+		"initialize",
+		&CTransmitManager::Initialize,
+		"Hook the given CheckTransmit function.\n\n"
+		":param Function function:\n"
+		"    The CheckTransmit function of the game.",
+		args("function"));
+
+	TransmitManager.def_readwrite(
+		"hide_owned_entities",
+		&CTransmitManager::m_bHideOwnedEntities,
+		"If True, entities owned by a hidden player (e.g. weapons) are hidden as well.");
+
+	TransmitManager.def_readwrite(
+		"use_visibility_matrix",
+		&CTransmitManager::m_bUseVisibility,
+		"If True, players that are not visible according to the visibility matrix are hidden.");
+
+	_entities.attr("transmit_manager") = object(ptr(&g_TransmitManager));
+}
+
+
+//-----------------------------------------------------------------------------
+// Exports CEntitySpatialIndex.
+//-----------------------------------------------------------------------------
+void export_entity_spatial_index(scope _entities)
+{
+	class_<CEntitySpatialIndex, boost::noncopyable> EntitySpatialIndex("EntitySpatialIndex", no_init);
+
+	EntitySpatialIndex.def(
+		"entities_in_sphere",
+		&CEntitySpatialIndex::EntitiesInSphere,
+		"Return the indexes of all entities whose bounds intersect the given sphere.\n\n"
+		":param Vector center:\n"
+		"    The center of the sphere.\n"
+		":param float radius:\n"
+		"    The radius of the sphere.\n"
+		":param str/iterable classnames:\n"
+		"    If given, only entities with one of these classnames are returned.\n"
+		":return:\n"
+		"    The entity indexes as ``array('H')``.\n"
+		":rtype: array",
+		(arg("center"), arg("radius"), arg("classnames")=object()));
+
+	EntitySpatialIndex.def(
+		"entities_in_box",
+		&CEntitySpatialIndex::EntitiesInBox,
+		"Return the indexes of all entities whose bounds intersect the given box.\n\n"
+		":param Vector mins:\n"
+		"    The minimum corner of the box.\n"
+		":param Vector maxs:\n"
+		"    The maximum corner of the box.\n"
+		":param str/iterable classnames:\n"
+		"    If given, only entities with one of these classnames are returned.\n"
+		":return:\n"
+		"    The entity indexes as ``array('H')``.\n"
+		":rtype: array",
+		(arg("mins"), arg("maxs"), arg("classnames")=object()));
+
+	EntitySpatialIndex.def(
+		"get_origins",
+		&CEntitySpatialIndex::GetOrigins,
+		"Return the origins of the given entities.\n\n"
+		":param iterable indexes:\n"
+		"    The entity indexes, e.g. the result of a query.\n"
+		":rtype: VectorArray",
+		args("indexes"));
+
+	EntitySpatialIndex.def(
+		"update",
+		&CEntitySpatialIndex::Update,
+		"Re-insert all entities that have moved since the last update. "
+		"This is done automatically once per tick before the first query.\n\n"
+		"Only existing entities are visited. They are tracked through the entity "
+		"create and delete notifications, but the bounds of each of them are "
+		"still compared once per tick.");
+
+	EntitySpatialIndex.def(
+		"clear",
+		&CEntitySpatialIndex::Clear,
+		"Remove all entities. The index is rebuilt on the next query.");
+
+	EntitySpatialIndex.add_property(
+		"cell_size",
+		&CEntitySpatialIndex::GetCellSize,
+		&CEntitySpatialIndex::SetCellSize,
+		"The edge length of a grid cell. Changing it clears the index.\n\n"
+		":rtype: float");
+
+	_entities.attr("entity_spatial_index") = object(ptr(&g_EntitySpatialIndex));
+}
+
+
 //-----------------------------------------------------------------------------
 // Exports CBaseEntityGenerator.
 //-----------------------------------------------------------------------------
@@ -0,0 +1,203 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2016 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+// SDK
+#include "vstdlib/IKeyValuesSystem.h"
+
+// Source.Python
+#include "utilities/wrap_macros.h"
+#include "events.h"
+
+
+//-----------------------------------------------------------------------------
+// CGameEventAccessor
+//-----------------------------------------------------------------------------
+CGameEventAccessor::CGameEventAccessor(const char* szEventName, object fields)
+{
+	CGameEventDescriptor* pDescriptor = GetGameEventDescriptor(szEventName);
+	if (!pDescriptor)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Event '%s' does not exist.", szEventName)
+
+	m_iEventID = pDescriptor->eventid;
+	V_strncpy(m_szEventName, szEventName, sizeof(m_szEventName));
+
+	// Compile all variables of the event if no names were given
+	if (fields.is_none())
+	{
+		KeyValues* pKey = pDescriptor->keys->GetFirstSubKey();
+		while (pKey)
+		{
+			AddField(pDescriptor, pKey->GetName());
+			pKey = pKey->GetNextKey();
+		}
+		return;
+	}
+
+	for (int i=0; i < len(fields); ++i)
+	{
+		const char* szName = extract<const char*>(fields[i]);
+		AddField(pDescriptor, szName);
+	}
+}
+
+void CGameEventAccessor::AddField(CGameEventDescriptor* pDescriptor, const char* szName)
+{
+	KeyValues* pKey = pDescriptor->keys->FindKey(szName);
+	if (!pKey)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Event '%s' has no variable '%s'.", m_szEventName, szName)
+
+	EventField_t field;
+	field.m_iKeySymbol = KeyValuesSystem()->GetSymbolForString(szName);
+	field.m_Type = (EventVarType) atoi(pKey->GetString());
+	m_Fields.AddToTail(field);
+}
+
+bool CGameEventAccessor::IsCompatible(IGameEvent* pEvent)
+{
+	return IGameEventExt::GetDescriptor(pEvent)->eventid == m_iEventID;
+}
+
+KeyValues* CGameEventAccessor::GetVariables(IGameEvent* pEvent)
+{
+	if (!pEvent)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Event is NULL.")
+
+	if (!IsCompatible(pEvent))
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Accessor was compiled for '%s', but got '%s'.", m_szEventName, pEvent->GetName())
+
+	return IGameEventExt::GetVariables(pEvent);
+}
+
+object CGameEventAccessor::GetValue(KeyValues* pVariables, EventField_t& field)
+{
+	KeyValues* pKey = pVariables->FindKey(field.m_iKeySymbol);
+	switch (field.m_Type)
+	{
+		case TYPE_STRING:
+		case TYPE_WSTRING:
+		{
+			const char* szValue = pKey ? pKey->GetString() : "";
+			return object(handle<>(PyUnicode_DecodeUTF8(szValue, strlen(szValue), "ignore")));
+		}
+		case TYPE_FLOAT:
+			return object(pKey ? pKey->GetFloat() : 0.0f);
+		case TYPE_LONG:
+		case TYPE_SHORT:
+		case TYPE_BYTE:
+			return object(pKey ? pKey->GetInt() : 0);
+		case TYPE_UINT64:
+			return object(pKey ? pKey->GetUint64() : 0);
+		case TYPE_BOOL:
+			return object(pKey ? pKey->GetInt() != 0 : false);
+	}
+
+	// Local variables don't have a fixed type, so use the stored one
+	if (!pKey)
+		return object();
+
+	return KeyValuesExt::__getitem__(pVariables, pKey->GetName());
+}
+
+tuple CGameEventAccessor::Read(IGameEvent* pEvent)
+{
+	KeyValues* pVariables = GetVariables(pEvent);
+
+	PyObject* pResult = PyTuple_New(m_Fields.Count());
+	if (!pResult)
+		throw_error_already_set();
+
+	tuple result = tuple(handle<>(pResult));
+	for (int i=0; i < m_Fields.Count(); ++i)
+	{
+		object value = GetValue(pVariables, m_Fields[i]);
+		PyTuple_SET_ITEM(pResult, i, incref(value.ptr()));
+	}
+
+	return result;
+}
+
+dict CGameEventAccessor::ReadDict(IGameEvent* pEvent)
+{
+	KeyValues* pVariables = GetVariables(pEvent);
+
+	dict result;
+	for (int i=0; i < m_Fields.Count(); ++i)
+		result[GetFieldName(i)] = GetValue(pVariables, m_Fields[i]);
+
+	return result;
+}
+
+object CGameEventAccessor::ReadField(IGameEvent* pEvent, const char* szName)
+{
+	KeyValues* pVariables = GetVariables(pEvent);
+
+	int iKeySymbol = KeyValuesSystem()->GetSymbolForString(szName, false);
+	for (int i=0; i < m_Fields.Count(); ++i)
+	{
+		if (m_Fields[i].m_iKeySymbol == iKeySymbol)
+			return GetValue(pVariables, m_Fields[i]);
+	}
+
+	BOOST_RAISE_EXCEPTION(PyExc_KeyError, "Variable '%s' has not been compiled.", szName)
+	return object();
+}
+
+const char* CGameEventAccessor::GetEventName()
+{
+	return m_szEventName;
+}
+
+int CGameEventAccessor::GetEventID()
+{
+	return m_iEventID;
+}
+
+tuple CGameEventAccessor::GetFields()
+{
+	list result;
+	for (int i=0; i < m_Fields.Count(); ++i)
+		result.append(GetFieldName(i));
+
+	return tuple(result);
+}
+
+int CGameEventAccessor::GetFieldCount()
+{
+	return m_Fields.Count();
+}
+
+EventField_t& CGameEventAccessor::GetField(int iIndex)
+{
+	return m_Fields[iIndex];
+}
+
+const char* CGameEventAccessor::GetFieldName(int iIndex)
+{
+	return KeyValuesSystem()->GetStringForSymbol(m_Fields[iIndex].m_iKeySymbol);
+}
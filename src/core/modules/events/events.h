@@ -31,6 +31,7 @@
 // Includes.
 //-----------------------------------------------------------------------------
 #include "igameevents.h"
+#include "tier1/utlvector.h"
 #include "modules/keyvalues/keyvalues.h"
 #include "events_generator.h"
 
@@ -151,4 +152,50 @@ public:
 };
 
 
+//-----------------------------------------------------------------------------
+// A single compiled event variable.
+//-----------------------------------------------------------------------------
+struct EventField_t
+{
+	int				m_iKeySymbol;
+	EventVarType	m_Type;
+};
+
+
+//-----------------------------------------------------------------------------
+// Reads several event variables at once. The variable names are resolved to
+// KeyValues symbols and their types are taken from the event descriptor only
+// once, when the accessor is created.
+//-----------------------------------------------------------------------------
+class CGameEventAccessor
+{
+public:
+	CGameEventAccessor(const char* szEventName, object fields);
+
+	tuple Read(IGameEvent* pEvent);
+	dict ReadDict(IGameEvent* pEvent);
+	object ReadField(IGameEvent* pEvent, const char* szName);
+
+	const char* GetEventName();
+	int GetEventID();
+	tuple GetFields();
+	int GetFieldCount();
+
+	// Also used by other native consumers of game events.
+	bool IsCompatible(IGameEvent* pEvent);
+	EventField_t& GetField(int iIndex);
+	const char* GetFieldName(int iIndex);
+	static object GetValue(KeyValues* pVariables, EventField_t& field);
+
+private:
+	KeyValues* GetVariables(IGameEvent* pEvent);
+	void AddField(CGameEventDescriptor* pDescriptor, const char* szName);
+
+private:
+	int							m_iEventID;
+	char						m_szEventName[MAX_EVENT_NAME_LENGTH];
+	CUtlVector<EventField_t>	m_Fields;
+};
+
+
 #endif // _EVENTS_H
@@ -66,3 +66,20 @@ CGameEventDescriptor& CGameEventDescriptorIter::__next__()
 		
 	return game_events->Element(current_index++);
 }
+
+
+//-----------------------------------------------------------------------------
+// Functions.
+//-----------------------------------------------------------------------------
+CGameEventDescriptor* GetGameEventDescriptor(const char* szEventName)
+{
+	CGameEventManager2* manager = (CGameEventManager2*) gameeventmanager;
+	for (int i=0; i < manager->game_events.Count(); ++i)
+	{
+		CGameEventDescriptor& descriptor = manager->game_events.Element(i);
+		if (V_strcmp(descriptor.GetName(), szEventName) == 0)
+			return &descriptor;
+	}
+
+	return NULL;
+}
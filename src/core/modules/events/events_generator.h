@@ -137,4 +137,10 @@ private:
 	int current_index;
 };
 
+
+//-----------------------------------------------------------------------------
+// Functions.
+//-----------------------------------------------------------------------------
+CGameEventDescriptor* GetGameEventDescriptor(const char* szEventName);
+
 #endif // _EVENTS_GENERATOR_H
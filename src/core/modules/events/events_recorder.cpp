@@ -0,0 +1,439 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2016 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+// C++
+#include <stdio.h>
+
+// SDK
+#include "edict.h"
+
+// Source.Python
+#include "utilities/wrap_macros.h"
+#include "events_recorder.h"
+
+
+//-----------------------------------------------------------------------------
+// External variables.
+//-----------------------------------------------------------------------------
+extern IGameEventManager2* gameeventmanager;
+extern CGlobalVars* gpGlobals;
+
+
+//-----------------------------------------------------------------------------
+// Helpers.
+//-----------------------------------------------------------------------------
+class CLineWriter
+{
+public:
+	CLineWriter(char* szBuffer, int iSize)
+	{
+		m_szBuffer = szBuffer;
+		m_iSize = iSize;
+		m_iLength = 0;
+		m_bOverflow = false;
+	}
+
+	void Write(const char* szFormat, ...)
+	{
+		if (m_bOverflow)
+			return;
+
+		va_list args;
+		va_start(args, szFormat);
+		int iWritten = V_vsnprintf(m_szBuffer + m_iLength, m_iSize - m_iLength, szFormat, args);
+		va_end(args);
+
+		if (iWritten < 0 || iWritten >= m_iSize - m_iLength)
+			m_bOverflow = true;
+		else
+			m_iLength += iWritten;
+	}
+
+	void WriteChar(char c)
+	{
+		if (m_iLength + 1 >= m_iSize)
+			m_bOverflow = true;
+		else
+			m_szBuffer[m_iLength++] = c;
+	}
+
+	void WriteString(const char* szValue)
+	{
+		WriteChar('"');
+		for (const unsigned char* p = (const unsigned char*) szValue; *p && !m_bOverflow; ++p)
+		{
+			switch (*p)
+			{
+				case '"':  Write("\\\""); break;
+				case '\\': Write("\\\\"); break;
+				case '\n': Write("\\n"); break;
+				case '\r': Write("\\r"); break;
+				case '\t': Write("\\t"); break;
+				default:
+					if (*p < 0x20)
+						Write("\\u%04x", *p);
+					else
+						WriteChar(*p);
+			}
+		}
+		WriteChar('"');
+	}
+
+public:
+	char*	m_szBuffer;
+	int		m_iSize;
+	int		m_iLength;
+	bool	m_bOverflow;
+};
+
+
+//-----------------------------------------------------------------------------
+// CGameEventRecorder
+//-----------------------------------------------------------------------------
+CGameEventRecorder::CGameEventRecorder()
+{
+	m_uiRecorded = 0;
+	m_uiDropped = 0;
+	m_uiWritten = 0;
+	m_uiLost = 0;
+	m_uiRotations = 0;
+
+	m_pBuffer = NULL;
+	m_iBufferSize = 0;
+	m_iHead = 0;
+	m_iUsed = 0;
+
+	m_pStaging = NULL;
+	m_hThread = NULL;
+	m_bRunning = false;
+	m_iFlushInterval = 0;
+
+	m_szPath[0] = '\0';
+	m_pFile = NULL;
+	m_lFileSize = 0;
+	m_lMaxFileSize = 0;
+	m_iMaxFiles = 0;
+}
+
+CGameEventRecorder::~CGameEventRecorder()
+{
+	Stop();
+}
+
+void CGameEventRecorder::Start(const char* szPath, object event_names, int iBufferSize,
+	int iMaxFileSize, int iMaxFiles, int iFlushInterval)
+{
+	if (m_bRunning)
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "Recorder is already running.")
+
+	if (iBufferSize < EVENT_RECORDER_MAX_LINE_LENGTH)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Buffer size must be at least %i bytes.", EVENT_RECORDER_MAX_LINE_LENGTH)
+
+	if (iMaxFileSize < 0)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Maximum file size must not be negative.")
+
+	if (iMaxFiles < 0)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Maximum number of files must not be negative.")
+
+	// A zero timeout would make the writer thread spin
+	if (iFlushInterval <= 0)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Flush interval must be greater than 0.")
+
+	// Compile all events before subscribing to any of them. Nothing of a
+	// failed attempt may be left behind for the next call.
+	try
+	{
+		for (int i=0; i < len(event_names); ++i)
+		{
+			const char* szEventName = extract<const char*>(event_names[i]);
+			CGameEventAccessor* pAccessor = new CGameEventAccessor(szEventName, object());
+
+			CGameEventAccessor*& pExisting = m_Accessors[pAccessor->GetEventID()];
+			delete pExisting;
+			pExisting = pAccessor;
+		}
+	}
+	catch (...)
+	{
+		ClearAccessors();
+		throw;
+	}
+
+	m_pFile = fopen(szPath, "ab");
+	if (!m_pFile)
+	{
+		ClearAccessors();
+		BOOST_RAISE_EXCEPTION(PyExc_IOError, "Unable to open '%s'.", szPath)
+	}
+
+	V_strncpy(m_szPath, szPath, sizeof(m_szPath));
+	fseek(m_pFile, 0, SEEK_END);
+	m_lFileSize = ftell(m_pFile);
+	m_lMaxFileSize = iMaxFileSize;
+	m_iMaxFiles = iMaxFiles;
+
+	m_pBuffer = new char[iBufferSize];
+	m_pStaging = new char[iBufferSize];
+	m_iBufferSize = iBufferSize;
+	m_iHead = 0;
+	m_iUsed = 0;
+
+	m_iFlushInterval = iFlushInterval;
+	m_bRunning = true;
+	m_FlushEvent.Reset();
+	m_hThread = CreateSimpleThread(&CGameEventRecorder::WriterThread, this);
+
+	boost::unordered_map<int, CGameEventAccessor*>::iterator it;
+	for (it = m_Accessors.begin(); it != m_Accessors.end(); ++it)
+		gameeventmanager->AddListener(this, it->second->GetEventName(), true);
+}
+
+void CGameEventRecorder::Stop()
+{
+	if (!m_bRunning)
+		return;
+
+	gameeventmanager->RemoveListener(this);
+
+	// Let the writer thread do a final flush and exit
+	m_bRunning = false;
+	m_FlushEvent.Set();
+	ThreadJoin(m_hThread);
+	ReleaseThreadHandle(m_hThread);
+	m_hThread = NULL;
+
+	if (m_pFile)
+	{
+		fclose(m_pFile);
+		m_pFile = NULL;
+	}
+
+	delete[] m_pBuffer;
+	delete[] m_pStaging;
+	m_pBuffer = NULL;
+	m_pStaging = NULL;
+	m_iBufferSize = 0;
+
+	ClearAccessors();
+}
+
+bool CGameEventRecorder::IsRunning()
+{
+	return m_bRunning;
+}
+
+void CGameEventRecorder::Flush()
+{
+	if (m_bRunning)
+		m_FlushEvent.Set();
+}
+
+void CGameEventRecorder::ClearAccessors()
+{
+	boost::unordered_map<int, CGameEventAccessor*>::iterator it;
+	for (it = m_Accessors.begin(); it != m_Accessors.end(); ++it)
+		delete it->second;
+
+	m_Accessors.clear();
+}
+
+void CGameEventRecorder::FireGameEvent(IGameEvent* pEvent)
+{
+	boost::unordered_map<int, CGameEventAccessor*>::iterator it = m_Accessors.find(
+		IGameEventExt::GetDescriptor(pEvent)->eventid);
+
+	if (it == m_Accessors.end())
+		return;
+
+	char szLine[EVENT_RECORDER_MAX_LINE_LENGTH];
+	int iLength = Serialize(pEvent, it->second, szLine, sizeof(szLine));
+	if (iLength < 0 || !Push(szLine, iLength))
+	{
+		m_uiDropped++;
+		return;
+	}
+
+	m_uiRecorded++;
+}
+
+int CGameEventRecorder::GetEventDebugID()
+{
+	return EVENT_DEBUG_ID_INIT;
+}
+
+int CGameEventRecorder::Serialize(IGameEvent* pEvent, CGameEventAccessor* pAccessor, char* szBuffer, int iSize)
+{
+	CLineWriter writer(szBuffer, iSize);
+	writer.Write("{\"tick\":%i,\"time\":%f,\"event\":", gpGlobals->tickcount, gpGlobals->curtime);
+	writer.WriteString(pAccessor->GetEventName());
+
+	KeyValues* pVariables = IGameEventExt::GetVariables(pEvent);
+	for (int i=0; i < pAccessor->GetFieldCount(); ++i)
+	{
+		EventField_t& field = pAccessor->GetField(i);
+		KeyValues* pKey = pVariables->FindKey(field.m_iKeySymbol);
+
+		writer.WriteChar(',');
+		writer.WriteString(pAccessor->GetFieldName(i));
+		writer.WriteChar(':');
+
+		switch (field.m_Type)
+		{
+			case TYPE_FLOAT:
+			{
+				float fValue = pKey ? pKey->GetFloat() : 0.0f;
+				if (IsFinite(fValue))
+					writer.Write("%g", fValue);
+				else
+					writer.Write("null");
+				break;
+			}
+			case TYPE_LONG:
+			case TYPE_SHORT:
+			case TYPE_BYTE:
+				writer.Write("%i", pKey ? pKey->GetInt() : 0);
+				break;
+			case TYPE_UINT64:
+				writer.Write("%llu", pKey ? (unsigned long long) pKey->GetUint64() : 0ULL);
+				break;
+			case TYPE_BOOL:
+				writer.Write(pKey && pKey->GetInt() ? "true" : "false");
+				break;
+			default:
+				writer.WriteString(pKey ? pKey->GetString() : "");
+		}
+	}
+
+	writer.WriteChar('}');
+	writer.WriteChar('\n');
+	return writer.m_bOverflow ? -1 : writer.m_iLength;
+}
+
+bool CGameEventRecorder::Push(const char* szLine, int iLength)
+{
+	AUTO_LOCK(m_BufferMutex);
+	if (m_iUsed + iLength > m_iBufferSize)
+		return false;
+
+	int iTail = (m_iHead + m_iUsed) % m_iBufferSize;
+	int iFirst = MIN(iLength, m_iBufferSize - iTail);
+	memcpy(m_pBuffer + iTail, szLine, iFirst);
+	memcpy(m_pBuffer, szLine + iFirst, iLength - iFirst);
+	m_iUsed += iLength;
+	return true;
+}
+
+void CGameEventRecorder::WriteToDisk()
+{
+	int iLength;
+	{
+		AUTO_LOCK(m_BufferMutex);
+		iLength = m_iUsed;
+		int iFirst = MIN(iLength, m_iBufferSize - m_iHead);
+		memcpy(m_pStaging, m_pBuffer + m_iHead, iFirst);
+		memcpy(m_pStaging + iFirst, m_pBuffer, iLength - iFirst);
+		m_iHead = (m_iHead + iLength) % m_iBufferSize;
+		m_iUsed = 0;
+	}
+
+	if (!iLength)
+		return;
+
+	if (m_pFile && m_lMaxFileSize > 0 && m_lFileSize > 0 && m_lFileSize + iLength > m_lMaxFileSize)
+		Rotate();
+
+	// Try to reopen the file if a previous rotation failed
+	if (!m_pFile)
+	{
+		m_pFile = fopen(m_szPath, "ab");
+		if (m_pFile)
+		{
+			fseek(m_pFile, 0, SEEK_END);
+			m_lFileSize = ftell(m_pFile);
+		}
+	}
+
+	int iWritten = m_pFile ? (int) fwrite(m_pStaging, 1, iLength, m_pFile) : 0;
+	if (m_pFile)
+		fflush(m_pFile);
+
+	m_lFileSize += iWritten;
+	m_uiWritten += iWritten;
+
+	// Every event is a single line, so count the lines that didn't make it
+	for (int i=iWritten; i < iLength; ++i)
+	{
+		if (m_pStaging[i] == '\n')
+			m_uiLost++;
+	}
+}
+
+void CGameEventRecorder::Rotate()
+{
+	fclose(m_pFile);
+	m_pFile = NULL;
+
+	// events.log.2 -> events.log.3, events.log.1 -> events.log.2, ...
+	char szOld[MAX_PATH + 16];
+	char szNew[MAX_PATH + 16];
+	for (int i=m_iMaxFiles - 1; i > 0; --i)
+	{
+		V_snprintf(szOld, sizeof(szOld), "%s.%i", m_szPath, i);
+		V_snprintf(szNew, sizeof(szNew), "%s.%i", m_szPath, i + 1);
+		remove(szNew);
+		rename(szOld, szNew);
+	}
+
+	// If no backups are wanted, the current file is simply truncated
+	if (m_iMaxFiles > 0)
+	{
+		V_snprintf(szNew, sizeof(szNew), "%s.1", m_szPath);
+		remove(szNew);
+		rename(m_szPath, szNew);
+	}
+
+	m_pFile = fopen(m_szPath, "wb");
+
+	m_lFileSize = 0;
+	m_uiRotations++;
+}
+
+unsigned CGameEventRecorder::WriterThread(void* pParam)
+{
+	CGameEventRecorder* pRecorder = (CGameEventRecorder*) pParam;
+	while (pRecorder->m_bRunning)
+	{
+		pRecorder->m_FlushEvent.Wait(pRecorder->m_iFlushInterval);
+		pRecorder->WriteToDisk();
+	}
+
+	// Write everything that has been recorded before the recorder was stopped
+	pRecorder->WriteToDisk();
+	return 0;
+}
@@ -0,0 +1,113 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2015 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+#ifndef _EVENTS_RECORDER_H
+#define _EVENTS_RECORDER_H
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+// Boost
+#include "boost/unordered_map.hpp"
+
+// SDK
+#include "igameevents.h"
+#include "tier0/threadtools.h"
+
+// Source.Python
+#include "events.h"
+
+
+//-----------------------------------------------------------------------------
+// Definitions.
+//-----------------------------------------------------------------------------
+#define EVENT_RECORDER_MAX_LINE_LENGTH 4096
+
+
+//-----------------------------------------------------------------------------
+// Writes game events as JSON lines to a rotating file. Events are serialized
+// on the game thread into a ring buffer without calling Python, and a
+// background thread flushes the buffer to disk.
+//-----------------------------------------------------------------------------
+class CGameEventRecorder: public IGameEventListener2
+{
+public:
+	CGameEventRecorder();
+	virtual ~CGameEventRecorder();
+
+	void Start(const char* szPath, object event_names, int iBufferSize, int iMaxFileSize,
+		int iMaxFiles, int iFlushInterval);
+	void Stop();
+	bool IsRunning();
+	void Flush();
+
+	// IGameEventListener2
+	virtual void FireGameEvent(IGameEvent* pEvent);
+	virtual int GetEventDebugID();
+
+public:
+	unsigned int m_uiRecorded;
+	unsigned int m_uiDropped;
+	unsigned int m_uiWritten;
+	unsigned int m_uiLost;
+	unsigned int m_uiRotations;
+
+private:
+	int Serialize(IGameEvent* pEvent, CGameEventAccessor* pAccessor, char* szBuffer, int iSize);
+	bool Push(const char* szLine, int iLength);
+	void WriteToDisk();
+	void Rotate();
+	void ClearAccessors();
+
+	static unsigned WriterThread(void* pParam);
+
+private:
+	boost::unordered_map<int, CGameEventAccessor*> m_Accessors;
+
+	// Ring buffer
+	char*				m_pBuffer;
+	int					m_iBufferSize;
+	int					m_iHead;
+	int					m_iUsed;
+	CThreadFastMutex	m_BufferMutex;
+
+	// Writer thread
+	char*				m_pStaging;
+	ThreadHandle_t		m_hThread;
+	CThreadEvent		m_FlushEvent;
+	volatile bool		m_bRunning;
+	int					m_iFlushInterval;
+
+	// Output file
+	char				m_szPath[MAX_PATH];
+	FILE*				m_pFile;
+	long				m_lFileSize;
+	long				m_lMaxFileSize;
+	int					m_iMaxFiles;
+};
+
+
+#endif // _EVENTS_RECORDER_H
@@ -32,6 +32,7 @@
 #include "events.h"
 #include "igameevents.h"
 #include "events_generator.h"
+#include "events_recorder.h"
 
 
 //-----------------------------------------------------------------------------
@@ -49,6 +50,8 @@ static void export_igameeventmanager(scope);
 static void export_gameeventdescriptor_iter(scope);
 static void export_gameeventdescriptor(scope);
 static void export_eventvartype(scope);
+static void export_gameeventaccessor(scope);
+static void export_gameeventrecorder(scope);
 
 
 //-----------------------------------------------------------------------------
@@ -62,6 +65,8 @@ DECLARE_SP_MODULE(_events)
 	export_gameeventdescriptor_iter(_events);
 	export_gameeventdescriptor(_events);
 	export_eventvartype(_events);
+	export_gameeventaccessor(_events);
+	export_gameeventrecorder(_events);
 }
 
 
@@ -389,3 +394,155 @@ static void export_eventvartype(scope _events)
 	_EventVarType.value("UINT64", TYPE_UINT64);
 	_EventVarType.value("WSTRING", TYPE_WSTRING);
 }
+
+
+
+//---------------------------------------------------------------------------------
+// Exports CGameEventAccessor.
+//---------------------------------------------------------------------------------
+static void export_gameeventaccessor(scope _events)
+{
+	class_<CGameEventAccessor, boost::noncopyable> GameEventAccessor(
+		"GameEventAccessor",
+		init<const char*, object>(
+			(arg("event_name"), arg("fields")=object()),
+			"Compile the given variables of an event.\n\n"
+			":param str event_name:\n"
+			"    Name of the event.\n"
+			":param iterable fields:\n"
+			"    Names of the variables to read. If None, all variables of the\n"
+			"    event will be compiled in the order of its descriptor.\n"
+			":raise ValueError:\n"
+			"    Raised if the event or one of the variables does not exist."
+		)
+	);
+
+	GameEventAccessor.def(
+		"read",
+		&CGameEventAccessor::Read,
+		"Return the compiled variables of the given event as a tuple.\n\n"
+		":param GameEvent game_event:\n"
+		"    The event to read. It must be of the compiled type.\n"
+		":rtype: tuple",
+		args("game_event")
+	);
+
+	GameEventAccessor.def(
+		"read_dict",
+		&CGameEventAccessor::ReadDict,
+		"Return the compiled variables of the given event as a dict.\n\n"
+		":rtype: dict",
+		args("game_event")
+	);
+
+	GameEventAccessor.def(
+		"read_field",
+		&CGameEventAccessor::ReadField,
+		"Return a single compiled variable of the given event.\n\n"
+		":raise KeyError:\n"
+		"    Raised if the variable has not been compiled.",
+		args("game_event", "name")
+	);
+
+	GameEventAccessor.add_property(
+		"event_name",
+		&CGameEventAccessor::GetEventName,
+		"Return the name of the compiled event.\n\n"
+		":rtype: str"
+	);
+
+	GameEventAccessor.add_property(
+		"fields",
+		&CGameEventAccessor::GetFields,
+		"Return the names of the compiled variables in reading order.\n\n"
+		":rtype: tuple"
+	);
+
+	GameEventAccessor.def(
+		"__len__",
+		&CGameEventAccessor::GetFieldCount,
+		"Return the number of compiled variables."
+	);
+}
+
+
+//---------------------------------------------------------------------------------
+// Exports CGameEventRecorder.
+//---------------------------------------------------------------------------------
+static void export_gameeventrecorder(scope _events)
+{
+	class_<CGameEventRecorder, boost::noncopyable> GameEventRecorder("GameEventRecorder");
+
+	GameEventRecorder.def(
+		"start",
+		&CGameEventRecorder::Start,
+		"Start recording the given events as JSON lines.\n\n"
+		":param str path:\n"
+		"    Path of the file to write to. Events are appended if it already exists.\n"
+		":param iterable event_names:\n"
+		"    Names of the events to record.\n"
+		":param int buffer_size:\n"
+		"    Size of the ring buffer in bytes. Events are dropped if it is full.\n"
+		":param int max_file_size:\n"
+		"    Size in bytes after which the file is rotated. 0 disables rotation.\n"
+		":param int max_files:\n"
+		"    Number of rotated files to keep (``path.1``, ``path.2``, ...).\n"
+		":param int flush_interval:\n"
+		"    Milliseconds between two flushes of the background thread. Must be greater than 0.\n"
+		":raise RuntimeError:\n"
+		"    Raised if the recorder is already running.\n"
+		":raise ValueError:\n"
+		"    Raised if one of the sizes, the number of files or the flush interval is invalid.",
+		("path", "event_names", arg("buffer_size")=1 << 20, arg("max_file_size")=0,
+			arg("max_files")=5, arg("flush_interval")=1000)
+	);
+
+	GameEventRecorder.def(
+		"stop",
+		&CGameEventRecorder::Stop,
+		"Stop recording and write all pending events to the file."
+	);
+
+	GameEventRecorder.def(
+		"flush",
+		&CGameEventRecorder::Flush,
+		"Wake up the background thread to write pending events immediately."
+	);
+
+	GameEventRecorder.add_property(
+		"is_running",
+		&CGameEventRecorder::IsRunning,
+		"Return True if the recorder is running.\n\n"
+		":rtype: bool"
+	);
+
+	GameEventRecorder.def_readonly(
+		"recorded",
+		&CGameEventRecorder::m_uiRecorded,
+		"Return the number of events that have been added to the buffer."
+	);
+
+	GameEventRecorder.def_readonly(
+		"dropped",
+		&CGameEventRecorder::m_uiDropped,
+		"Return the number of events that have been dropped, because the buffer was full."
+	);
+
+	GameEventRecorder.def_readonly(
+		"written",
+		&CGameEventRecorder::m_uiWritten,
+		"Return the number of bytes that have been written to disk."
+	);
+
+	GameEventRecorder.def_readonly(
+		"lost",
+		&CGameEventRecorder::m_uiLost,
+		"Return the number of events that could not be written to disk."
+	);
+
+	GameEventRecorder.def_readonly(
+		"rotations",
+		&CGameEventRecorder::m_uiRotations,
+		"Return the number of times the file has been rotated."
+	);
+}
\ No newline at end of file
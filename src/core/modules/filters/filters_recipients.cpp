@@ -32,6 +32,7 @@
 //---------------------------------------------------------------------------------
 #include "utilities/conversions.h"
 #include "filters_recipients.h"
+#include "modules/players/players_generator.h"
 #include "interface.h"
 #include "filesystem.h"
 #include "engine/iserverplugin.h"
@@ -98,7 +99,7 @@ int MRecipientFilter::GetRecipientIndex(int slot) const
 
 void MRecipientFilter::AddAllPlayers()
 {
-	m_Recipients.RemoveAll();
+	RemoveAllPlayers();
 
 	for(int i = 1; i <= gpGlobals->maxClients; i++)
 	{
@@ -113,8 +114,12 @@ void MRecipientFilter::AddAllPlayers()
 
 void MRecipientFilter::AddRecipient(int iPlayer)
 {
-	// Return if the recipient is already in the vector
-	if(m_Recipients.Find(iPlayer) != m_Recipients.InvalidIndex())
+	// Skip non-player entities.
+	if (iPlayer <= WORLD_ENTITY_INDEX || iPlayer > gpGlobals->maxClients)
+		return;
+
+	// Return if the recipient is already in the filter
+	if (m_Recipients.HasElement(iPlayer))
 		return;
 
 	// Make sure the player is valid
@@ -122,9 +127,7 @@ void MRecipientFilter::AddRecipient(int iPlayer)
 	if(!EdictFromIndex(iPlayer, pPlayer))
 		return;
 
-	// Skip non-player entities.
-	if (iPlayer > WORLD_ENTITY_INDEX && iPlayer <= gpGlobals->maxClients)
-		m_Recipients.AddToTail(iPlayer);
+	m_Recipients.AddToTail(iPlayer);
 }
 
 void MRecipientFilter::RemoveRecipient( int iPlayer )
@@ -141,3 +144,101 @@ bool MRecipientFilter::HasRecipient( int iPlayer )
 {
 	return m_Recipients.HasElement(iPlayer);
 }
+
+void MRecipientFilter::AddPlayers(unsigned int uiIsMask, unsigned int uiNotMask)
+{
+	SyncBits();
+	for(int i = 1; i <= gpGlobals->maxClients; i++)
+	{
+		if (m_Bits.IsBitSet(i))
+			continue;
+
+		unsigned int uiMask;
+		if (!GetPlayerFilterMask(i, uiMask) || !MatchesPlayerFilterMask(uiMask, uiIsMask, uiNotMask))
+			continue;
+
+		m_Recipients.AddToTail(i);
+		m_Bits.Set(i);
+	}
+}
+
+void MRecipientFilter::MergeRecipients(IRecipientFilter* pOther)
+{
+	RecipientBits other;
+	GetRecipientBits(pOther, other);
+
+	SyncBits();
+	uint32* pBase = m_Bits.Base();
+	const uint32* pOtherBase = other.Base();
+	for (int i = 0; i < m_Bits.GetNumDWords(); i++)
+		pBase[i] |= pOtherBase[i];
+
+	RebuildRecipients();
+}
+
+void MRecipientFilter::IntersectRecipients(IRecipientFilter* pOther)
+{
+	RecipientBits other;
+	GetRecipientBits(pOther, other);
+
+	SyncBits();
+	uint32* pBase = m_Bits.Base();
+	const uint32* pOtherBase = other.Base();
+	for (int i = 0; i < m_Bits.GetNumDWords(); i++)
+		pBase[i] &= pOtherBase[i];
+
+	RebuildRecipients();
+}
+
+void MRecipientFilter::RemoveRecipients(IRecipientFilter* pOther)
+{
+	RecipientBits other;
+	GetRecipientBits(pOther, other);
+
+	SyncBits();
+	uint32* pBase = m_Bits.Base();
+	const uint32* pOtherBase = other.Base();
+	for (int i = 0; i < m_Bits.GetNumDWords(); i++)
+		pBase[i] &= ~pOtherBase[i];
+
+	RebuildRecipients();
+}
+
+void MRecipientFilter::SyncBits()
+{
+	// The game is able to modify m_Recipients directly (e.g. replace an
+	// element in place), so the bits are always rebuilt before they are used.
+	m_Bits.ClearAll();
+	for (int i = 0; i < m_Recipients.Count(); i++)
+	{
+		int iPlayer = m_Recipients[i];
+		if (iPlayer > WORLD_ENTITY_INDEX && iPlayer <= ABSOLUTE_PLAYER_LIMIT)
+			m_Bits.Set(iPlayer);
+	}
+}
+
+void MRecipientFilter::RebuildRecipients()
+{
+	m_Recipients.RemoveAll();
+	for (int i = 1; i <= ABSOLUTE_PLAYER_LIMIT; i++)
+	{
+		if (!m_Bits.IsBitSet(i))
+			continue;
+
+		m_Recipients.AddToTail(i);
+	}
+}
+
+void MRecipientFilter::GetRecipientBits(IRecipientFilter* pFilter, RecipientBits& output)
+{
+	output.ClearAll();
+	if (!pFilter)
+		return;
+
+	for (int i = 0; i < pFilter->GetRecipientCount(); i++)
+	{
+		int iPlayer = pFilter->GetRecipientIndex(i);
+		if (iPlayer > WORLD_ENTITY_INDEX && iPlayer <= ABSOLUTE_PLAYER_LIMIT)
+			output.Set(iPlayer);
+	}
+}
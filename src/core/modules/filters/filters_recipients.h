@@ -35,6 +35,7 @@
 //---------------------------------------------------------------------------------
 #include "irecipientfilter.h"
 #include "bitvec.h"
+#include "const.h"
 #include "tier1/utlvector.h"
 #include "modules/memory/memory_alloc.h"
 
@@ -73,6 +74,12 @@ public:
 };
 
 
+//---------------------------------------------------------------------------------
+// Recipient bits indexed by player index.
+//---------------------------------------------------------------------------------
+typedef CBitVec<ABSOLUTE_PLAYER_LIMIT + 1> RecipientBits;
+
+
 //---------------------------------------------------------------------------------
 // IRecipientFilter extension class
 //---------------------------------------------------------------------------------
@@ -108,6 +115,16 @@ public:
 	void RemoveAllPlayers();
 	bool HasRecipient(int iPlayer);
 
+	void AddPlayers(unsigned int uiIsMask, unsigned int uiNotMask);
+	void MergeRecipients(IRecipientFilter* pOther);
+	void IntersectRecipients(IRecipientFilter* pOther);
+	void RemoveRecipients(IRecipientFilter* pOther);
+
+private:
+	void SyncBits();
+	void RebuildRecipients();
+	static void GetRecipientBits(IRecipientFilter* pFilter, RecipientBits& output);
+
 public:
 	bool				m_bReliable;
 	bool				m_bInitMessage;
@@ -122,6 +139,12 @@ public:
 	// If ignoring prediction cull, then external systems can determine
 	//  whether this is a special case where culling should not occur
 	bool				m_bIgnorePredictionCull;
+
+	// The members above must match CRecipientFilter, because the game casts
+	// recipient filters to it. m_Recipients is kept up to date, and this bit
+	// vector is rebuilt from it before every membership test and set
+	// operation.
+	RecipientBits		m_Bits;
 };
 
 
@@ -115,6 +115,36 @@ void export_mrecipientfilter(scope _recipients)
 			"Return True if the given index is in the recipient filter.",
 			args("index")
 		)
+
+		.def("add_players",
+			&MRecipientFilter::AddPlayers,
+			"Add all players matching the given filter masks.\n\n"
+			":param int is_mask: A player is added if it has all bits of this mask.\n"
+			":param int not_mask: A player is not added if it has any bit of this mask.\n\n"
+			".. seealso:: :class:`players.PlayerFilterMask` and :func:`players.get_team_filter_mask`",
+			(arg("is_mask")=0, arg("not_mask")=0)
+		)
+
+		.def("merge_recipients",
+			&MRecipientFilter::MergeRecipients,
+			"Add all recipients of the given filter.\n\n"
+			":param BaseRecipientFilter other: The filter to merge.",
+			args("other")
+		)
+
+		.def("intersect_recipients",
+			&MRecipientFilter::IntersectRecipients,
+			"Remove all recipients that are not in the given filter.\n\n"
+			":param BaseRecipientFilter other: The filter to intersect with.",
+			args("other")
+		)
+
+		.def("remove_recipients",
+			&MRecipientFilter::RemoveRecipients,
+			"Remove all recipients of the given filter.\n\n"
+			":param BaseRecipientFilter other: The filter whose recipients should be removed.",
+			args("other")
+		)
 		
 		.def_readwrite("reliable",
 			&MRecipientFilter::m_bReliable,
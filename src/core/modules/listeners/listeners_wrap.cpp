@@ -30,6 +30,7 @@
 #include "export_main.h"
 #include "utilities/wrap_macros.h"
 #include "listeners_manager.h"
+#include "sp_hooks.h"
 
 
 //-----------------------------------------------------------------------------
@@ -70,6 +71,7 @@ DEFINE_MANAGER_ACCESSOR(OnButtonStateChanged)
 // Forward declarations.
 //-----------------------------------------------------------------------------
 void export_listener_managers(scope);
+void export_run_command_field_listener_manager(scope);
 
 
 //-----------------------------------------------------------------------------
@@ -78,6 +80,7 @@ void export_listener_managers(scope);
 DECLARE_SP_MODULE(_listeners)
 {
 	export_listener_managers(_listeners);
+	export_run_command_field_listener_manager(_listeners);
 }
 
 
@@ -174,3 +177,51 @@ void export_listener_managers(scope _listeners)
 	_listeners.attr("on_player_run_command_listener_manager") = object(ptr(GetOnPlayerRunCommandListenerManager()));
 	_listeners.attr("on_button_state_changed_listener_manager") = object(ptr(GetOnButtonStateChangedListenerManager()));
 }
+
+
+//-----------------------------------------------------------------------------
+// Exports CRunCommandFieldListenerManager.
+//-----------------------------------------------------------------------------
+void export_run_command_field_listener_manager(scope _listeners)
+{
+	enum_<UserCmdField>("UserCmdField")
+		.value("COMMAND_NUMBER", USERCMD_FIELD_COMMAND_NUMBER)
+		.value("TICK_COUNT", USERCMD_FIELD_TICK_COUNT)
+		.value("VIEW_ANGLES", USERCMD_FIELD_VIEW_ANGLES)
+		.value("FORWARD_MOVE", USERCMD_FIELD_FORWARD_MOVE)
+		.value("SIDE_MOVE", USERCMD_FIELD_SIDE_MOVE)
+		.value("UP_MOVE", USERCMD_FIELD_UP_MOVE)
+		.value("BUTTONS", USERCMD_FIELD_BUTTONS)
+		.value("IMPULSE", USERCMD_FIELD_IMPULSE)
+		.value("WEAPON_SELECT", USERCMD_FIELD_WEAPON_SELECT)
+		.value("WEAPON_SUBTYPE", USERCMD_FIELD_WEAPON_SUBTYPE)
+		.value("RANDOM_SEED", USERCMD_FIELD_RANDOM_SEED)
+		.value("MOUSE_DX", USERCMD_FIELD_MOUSE_DX)
+		.value("MOUSE_DY", USERCMD_FIELD_MOUSE_DY)
+	;
+
+	class_<CRunCommandFieldListenerManager, boost::noncopyable>("RunCommandFieldListenerManager", no_init)
+		.def("register_listener",
+			&CRunCommandFieldListenerManager::RegisterListener,
+			"Register a callable object that is called with the player index, followed by the "
+			"requested fields in the order of their :class:`UserCmdField` bits. If it was "
+			"already registered, only its fields are updated.\n\n"
+			":param callable: The callable object.\n"
+			":param int fields: A combination of :class:`UserCmdField` values.",
+			args("callable", "fields")
+		)
+
+		.def("unregister_listener",
+			&CRunCommandFieldListenerManager::UnregisterListener,
+			"Remove a callable object. If it was not registered nothing will happen.",
+			args("callable")
+		)
+
+		.def("__len__",
+			&CRunCommandFieldListenerManager::GetCount,
+			"Return the number of registered listeners."
+		)
+	;
+
+	_listeners.attr("on_player_run_command_fields_listener_manager") = object(ptr(&g_RunCommandFieldListenerManager));
+}
@@ -30,9 +30,136 @@
 //-----------------------------------------------------------------------------
 // Includes.
 //-----------------------------------------------------------------------------
+// C++
+#include <vector>
+
+// Boost.Python
+#include "boost/python.hpp"
+using namespace boost::python;
+
+// SDK
 #include "mathlib/vector.h"
 
 
+//-----------------------------------------------------------------------------
+// Freelist for the Python instances of a wrapped value class.
+//
+// Vector and QAngle instances are returned by value from many accessors (e.g.
+// entity.origin), so the memory of freed instances is kept and reused for the
+// next instance instead of going back to the allocator.
+//-----------------------------------------------------------------------------
+#define INSTANCE_FREE_LIST_SIZE 1024
+
+template<class T>
+class CInstanceFreeList
+{
+public:
+	static void Install(object cls)
+	{
+		PyTypeObject* pType = (PyTypeObject*) cls.ptr();
+
+		// Garbage collected objects have a header in front of them
+		if (PyType_IS_GC(pType))
+			return;
+
+		s_pType = pType;
+		s_pOriginalAlloc = pType->tp_alloc;
+		s_pOriginalFree = pType->tp_free;
+		pType->tp_alloc = &Alloc;
+		pType->tp_free = &Free;
+	}
+
+	static PyObject* Alloc(PyTypeObject* pType, Py_ssize_t nItems)
+	{
+		if (pType != s_pType)
+			return s_pOriginalAlloc(pType, nItems);
+
+		// Every block is at least as large as required for a value holder,
+		// so every block of the list can be reused for it
+		Py_ssize_t nPooledItems = (Py_ssize_t) objects::additional_instance_size<objects::value_holder<T> >::value;
+		size_t size = _PyObject_VAR_SIZE(pType, (nItems > nPooledItems ? nItems : nPooledItems) + 1);
+
+		void* pMemory = NULL;
+		if (s_bEnabled && nItems <= nPooledItems && !s_FreeList.empty())
+		{
+			pMemory = s_FreeList.back();
+			s_FreeList.pop_back();
+			s_uiReused++;
+		}
+		else
+		{
+			pMemory = PyObject_MALLOC(size);
+			if (!pMemory)
+				return PyErr_NoMemory();
+		}
+
+		s_uiAllocated++;
+
+		// Same as PyType_GenericAlloc()
+		memset(pMemory, 0, size);
+		if (pType->tp_flags & Py_TPFLAGS_HEAPTYPE)
+			Py_INCREF(pType);
+
+		return (PyObject*) PyObject_INIT_VAR((PyVarObject*) pMemory, pType, nItems);
+	}
+
+	static void Free(void* pMemory)
+	{
+		if (Py_TYPE((PyObject*) pMemory) != s_pType)
+		{
+			s_pOriginalFree(pMemory);
+			return;
+		}
+
+		if (s_bEnabled && s_FreeList.size() < INSTANCE_FREE_LIST_SIZE)
+			s_FreeList.push_back(pMemory);
+		else
+			PyObject_FREE(pMemory);
+	}
+
+	static bool IsEnabled()
+	{
+		return s_bEnabled;
+	}
+
+	// Disabling the list releases the kept memory, so the cost of the
+	// allocations with and without the list can be compared
+	static void SetEnabled(bool bEnabled)
+	{
+		s_bEnabled = bEnabled;
+		if (bEnabled)
+			return;
+
+		for (std::vector<void*>::iterator it = s_FreeList.begin(); it != s_FreeList.end(); ++it)
+			PyObject_FREE(*it);
+
+		s_FreeList.clear();
+	}
+
+	static tuple GetStats()
+	{
+		return make_tuple(s_uiAllocated, s_uiReused, s_FreeList.size());
+	}
+
+private:
+	static PyTypeObject*		s_pType;
+	static allocfunc			s_pOriginalAlloc;
+	static freefunc				s_pOriginalFree;
+	static std::vector<void*>	s_FreeList;
+	static unsigned long		s_uiAllocated;
+	static unsigned long		s_uiReused;
+	static bool					s_bEnabled;
+};
+
+template<class T> PyTypeObject* CInstanceFreeList<T>::s_pType = NULL;
+template<class T> allocfunc CInstanceFreeList<T>::s_pOriginalAlloc = NULL;
+template<class T> freefunc CInstanceFreeList<T>::s_pOriginalFree = NULL;
+template<class T> std::vector<void*> CInstanceFreeList<T>::s_FreeList;
+template<class T> unsigned long CInstanceFreeList<T>::s_uiAllocated = 0;
+template<class T> unsigned long CInstanceFreeList<T>::s_uiReused = 0;
+template<class T> bool CInstanceFreeList<T>::s_bEnabled = true;
+
+
 //-----------------------------------------------------------------------------
 // Vector extension class.
 //-----------------------------------------------------------------------------
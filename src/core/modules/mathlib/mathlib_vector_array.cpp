@@ -0,0 +1,401 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2016 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+// Boost.Python
+#include "boost/python/stl_iterator.hpp"
+
+// SDK
+#include "mathlib/ssemath.h"
+
+// Source.Python
+#include "mathlib_vector_array.h"
+#include "utilities/wrap_macros.h"
+#include "utilities/sp_util.h"
+
+
+//-----------------------------------------------------------------------------
+// CVectorArray.
+//-----------------------------------------------------------------------------
+CVectorArray::CVectorArray()
+{
+	m_iExports = 0;
+}
+
+CVectorArray::CVectorArray(int iSize)
+{
+	m_iExports = 0;
+	Resize(iSize);
+}
+
+boost::shared_ptr<CVectorArray> CVectorArray::__init__(object data)
+{
+	boost::shared_ptr<CVectorArray> pArray(new CVectorArray());
+	if (data.is_none())
+		return pArray;
+
+	extract<int> size(data);
+	if (size.check())
+	{
+		pArray->Resize(size());
+		return pArray;
+	}
+
+	// Copy buffers of packed float triples, e.g. a player state view
+	if (PyObject_CheckBuffer(data.ptr()))
+	{
+		Py_buffer view;
+		if (PyObject_GetBuffer(data.ptr(), &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0)
+			throw_error_already_set();
+
+		const char* szFormat = view.format;
+		bool bValid = (!szFormat || strcmp(szFormat, "f") == 0 || strcmp(szFormat, "<f") == 0
+			|| strcmp(szFormat, "=f") == 0 || strcmp(szFormat, "B") == 0)
+			&& view.len % sizeof(Vector) == 0;
+
+		if (bValid)
+		{
+			pArray->m_Vectors.resize(view.len / sizeof(Vector));
+			if (view.len)
+				memcpy(&pArray->m_Vectors[0], view.buf, view.len);
+		}
+
+		PyBuffer_Release(&view);
+		if (!bValid)
+			BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Buffer must contain packed float triples.")
+
+		return pArray;
+	}
+
+	stl_input_iterator<Vector> begin(data), end;
+	pArray->m_Vectors.assign(begin, end);
+	return pArray;
+}
+
+int CVectorArray::GetSize()
+{
+	return (int) m_Vectors.size();
+}
+
+void CVectorArray::CheckResizable()
+{
+	if (m_iExports > 0)
+		BOOST_RAISE_EXCEPTION(PyExc_BufferError, "Existing exports of data: object cannot be re-sized.")
+}
+
+void CVectorArray::Resize(int iSize)
+{
+	if (iSize < 0)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Size must not be negative.")
+
+	CheckResizable();
+	m_Vectors.resize(iSize, vec3_origin);
+}
+
+void CVectorArray::Append(const Vector& vec)
+{
+	CheckResizable();
+	m_Vectors.push_back(vec);
+}
+
+void CVectorArray::Clear()
+{
+	CheckResizable();
+	m_Vectors.clear();
+}
+
+int CVectorArray::CheckIndex(int iIndex)
+{
+	int iSize = GetSize();
+	if (iIndex < 0)
+		iIndex += iSize;
+
+	if (iIndex < 0 || iIndex >= iSize)
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Index out of range (%d)", iIndex)
+
+	return iIndex;
+}
+
+Vector CVectorArray::GetItem(int iIndex)
+{
+	return m_Vectors[CheckIndex(iIndex)];
+}
+
+void CVectorArray::SetItem(int iIndex, const Vector& vec)
+{
+	m_Vectors[CheckIndex(iIndex)] = vec;
+}
+
+Vector* CVectorArray::GetData()
+{
+	return m_Vectors.empty() ? NULL : &m_Vectors[0];
+}
+
+void CVectorArray::GetDistancesSqr(const Vector& vecPoint, float* pOutput)
+{
+	int iCount = GetSize();
+	int i = 0;
+
+	FourVectors point;
+	point.DuplicateVector(vecPoint);
+	for (; i + 4 <= iCount; i += 4)
+	{
+		FourVectors vectors;
+		vectors.LoadAndSwizzle(m_Vectors[i], m_Vectors[i + 1], m_Vectors[i + 2], m_Vectors[i + 3]);
+		vectors -= point;
+		StoreUnalignedSIMD(pOutput + i, vectors.length2());
+	}
+
+	for (; i < iCount; i++)
+		pOutput[i] = m_Vectors[i].DistToSqr(vecPoint);
+}
+
+object CVectorArray::GetDistancesSqr(const Vector& vecPoint)
+{
+	std::vector<float> result(m_Vectors.size());
+	if (!result.empty())
+		GetDistancesSqr(vecPoint, &result[0]);
+
+	return MakeArray("f", result);
+}
+
+object CVectorArray::GetDistances(const Vector& vecPoint)
+{
+	std::vector<float> result(m_Vectors.size());
+	if (!result.empty())
+		GetDistancesSqr(vecPoint, &result[0]);
+
+	int iCount = GetSize();
+	int i = 0;
+	for (; i + 4 <= iCount; i += 4)
+		StoreUnalignedSIMD(&result[i], SqrtSIMD(LoadUnalignedSIMD(&result[i])));
+
+	for (; i < iCount; i++)
+		result[i] = sqrt(result[i]);
+
+	return MakeArray("f", result);
+}
+
+object CVectorArray::Dot(const Vector& vecOther)
+{
+	int iCount = GetSize();
+	std::vector<float> result(iCount);
+	int i = 0;
+
+	FourVectors other;
+	other.DuplicateVector(vecOther);
+	for (; i + 4 <= iCount; i += 4)
+	{
+		FourVectors vectors;
+		vectors.LoadAndSwizzle(m_Vectors[i], m_Vectors[i + 1], m_Vectors[i + 2], m_Vectors[i + 3]);
+		StoreUnalignedSIMD(&result[i], vectors * other);
+	}
+
+	for (; i < iCount; i++)
+		result[i] = m_Vectors[i].Dot(vecOther);
+
+	return MakeArray("f", result);
+}
+
+boost::shared_ptr<CVectorArray> CVectorArray::Cross(const Vector& vecOther)
+{
+	int iCount = GetSize();
+	boost::shared_ptr<CVectorArray> pResult(new CVectorArray(iCount));
+	int i = 0;
+
+	FourVectors other;
+	other.DuplicateVector(vecOther);
+	for (; i + 4 <= iCount; i += 4)
+	{
+		FourVectors vectors;
+		vectors.LoadAndSwizzle(m_Vectors[i], m_Vectors[i + 1], m_Vectors[i + 2], m_Vectors[i + 3]);
+
+		FourVectors cross;
+		cross.x = SubSIMD(MulSIMD(vectors.y, other.z), MulSIMD(vectors.z, other.y));
+		cross.y = SubSIMD(MulSIMD(vectors.z, other.x), MulSIMD(vectors.x, other.z));
+		cross.z = SubSIMD(MulSIMD(vectors.x, other.y), MulSIMD(vectors.y, other.x));
+
+		for (int j=0; j < 4; j++)
+			pResult->m_Vectors[i + j] = cross.Vec(j);
+	}
+
+	for (; i < iCount; i++)
+		CrossProduct(m_Vectors[i], vecOther, pResult->m_Vectors[i]);
+
+	return pResult;
+}
+
+void CVectorArray::Normalize()
+{
+	int iCount = GetSize();
+	int i = 0;
+
+	// Same as VectorNormalize(), which divides by the length plus epsilon
+	fltx4 epsilon = ReplicateX4(FLT_EPSILON);
+	for (; i + 4 <= iCount; i += 4)
+	{
+		FourVectors vectors;
+		vectors.LoadAndSwizzle(m_Vectors[i], m_Vectors[i + 1], m_Vectors[i + 2], m_Vectors[i + 3]);
+		vectors *= ReciprocalSIMD(AddSIMD(SqrtSIMD(vectors * vectors), epsilon));
+
+		for (int j=0; j < 4; j++)
+			m_Vectors[i + j] = vectors.Vec(j);
+	}
+
+	for (; i < iCount; i++)
+		VectorNormalize(m_Vectors[i]);
+}
+
+boost::shared_ptr<CVectorArray> CVectorArray::AnglesToForward()
+{
+	// Scalar, because there is no SIMD sine/cosine available on all engines
+	boost::shared_ptr<CVectorArray> pResult(new CVectorArray(GetSize()));
+	for (int i=0; i < GetSize(); i++)
+	{
+		const Vector& vec = m_Vectors[i];
+		AngleVectors(QAngle(vec.x, vec.y, vec.z), &pResult->m_Vectors[i]);
+	}
+
+	return pResult;
+}
+
+void CVectorArray::Transform(const matrix3x4_t& matrix)
+{
+	int iCount = GetSize();
+	int i = 0;
+
+	fltx4 rows[3][4];
+	for (int row=0; row < 3; row++)
+	{
+		for (int column=0; column < 4; column++)
+			rows[row][column] = ReplicateX4(matrix[row][column]);
+	}
+
+	for (; i + 4 <= iCount; i += 4)
+	{
+		FourVectors vectors;
+		vectors.LoadAndSwizzle(m_Vectors[i], m_Vectors[i + 1], m_Vectors[i + 2], m_Vectors[i + 3]);
+
+		// Same as VectorTransform(): rotate and add the translation column
+		fltx4 result[3];
+		for (int row=0; row < 3; row++)
+		{
+			result[row] = AddSIMD(
+				AddSIMD(MulSIMD(vectors.x, rows[row][0]), MulSIMD(vectors.y, rows[row][1])),
+				AddSIMD(MulSIMD(vectors.z, rows[row][2]), rows[row][3]));
+		}
+
+		vectors.x = result[0];
+		vectors.y = result[1];
+		vectors.z = result[2];
+
+		for (int j=0; j < 4; j++)
+			m_Vectors[i + j] = vectors.Vec(j);
+	}
+
+	for (; i < iCount; i++)
+	{
+		Vector vec = m_Vectors[i];
+		VectorTransform(vec, matrix, m_Vectors[i]);
+	}
+}
+
+object CVectorArray::FindWithinBox(const Vector& vecMins, const Vector& vecMaxs)
+{
+	std::vector<unsigned int> result;
+	for (int i=0; i < GetSize(); i++)
+	{
+		if (m_Vectors[i].WithinAABox(vecMins, vecMaxs))
+			result.push_back(i);
+	}
+
+	return MakeArray("I", result);
+}
+
+object CVectorArray::FindWithinRadius(const Vector& vecPoint, float flRadius)
+{
+	std::vector<float> distances(m_Vectors.size());
+	if (!distances.empty())
+		GetDistancesSqr(vecPoint, &distances[0]);
+
+	std::vector<unsigned int> result;
+	float flRadiusSqr = flRadius * flRadius;
+	for (unsigned int i=0; i < distances.size(); i++)
+	{
+		if (distances[i] <= flRadiusSqr)
+			result.push_back(i);
+	}
+
+	return MakeArray("I", result);
+}
+
+int CVectorArray::GetBuffer(PyObject* pExporter, Py_buffer* pView, int iFlags)
+{
+	CVectorArray* pArray = (CVectorArray*) converter::get_lvalue_from_python(
+		pExporter, converter::registered<CVectorArray>::converters);
+
+	if (!pArray)
+	{
+		pView->obj = NULL;
+		PyErr_SetString(PyExc_BufferError, "Object is not a VectorArray.");
+		return -1;
+	}
+
+	// Exported as a writable (n, 3) array of floats
+	static float s_fEmpty[3];
+	pArray->m_Shape[0] = pArray->GetSize();
+	pArray->m_Shape[1] = 3;
+	pArray->m_Strides[0] = sizeof(Vector);
+	pArray->m_Strides[1] = sizeof(float);
+
+	pView->obj = pExporter;
+	pView->buf = pArray->m_Vectors.empty() ? (void*) s_fEmpty : (void*) &pArray->m_Vectors[0];
+	pView->len = pArray->GetSize() * sizeof(Vector);
+	pView->readonly = 0;
+	pView->itemsize = sizeof(float);
+	pView->format = (iFlags & PyBUF_FORMAT) ? (char*) "f" : NULL;
+	pView->ndim = (iFlags & PyBUF_ND) ? 2 : 1;
+	pView->shape = (iFlags & PyBUF_ND) ? pArray->m_Shape : NULL;
+	pView->strides = ((iFlags & PyBUF_STRIDES) == PyBUF_STRIDES) ? pArray->m_Strides : NULL;
+	pView->suboffsets = NULL;
+	pView->internal = NULL;
+
+	Py_INCREF(pExporter);
+	pArray->m_iExports++;
+	return 0;
+}
+
+void CVectorArray::ReleaseBuffer(PyObject* pExporter, Py_buffer* pView)
+{
+	CVectorArray* pArray = (CVectorArray*) converter::get_lvalue_from_python(
+		pExporter, converter::registered<CVectorArray>::converters);
+
+	if (pArray)
+		pArray->m_iExports--;
+}
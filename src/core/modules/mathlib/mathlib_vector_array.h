@@ -0,0 +1,101 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2016 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+#ifndef _MATHLIB_VECTOR_ARRAY_H
+#define _MATHLIB_VECTOR_ARRAY_H
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+// C++
+#include <vector>
+
+// Boost.Python
+#include "boost/python.hpp"
+using namespace boost::python;
+
+// SDK
+#include "mathlib/vector.h"
+#include "mathlib/mathlib.h"
+
+
+//-----------------------------------------------------------------------------
+// A packed array of vectors (or angles) that supports the buffer protocol.
+//
+// The vectors are stored as float triples without padding, so the array can
+// be passed to every API that accepts packed float triples. Batch kernels
+// process four vectors at once using the SSE types of the SDK.
+//-----------------------------------------------------------------------------
+class CVectorArray
+{
+public:
+	CVectorArray();
+	CVectorArray(int iSize);
+
+	static boost::shared_ptr<CVectorArray> __init__(object data);
+
+	// Container methods
+	int GetSize();
+	void Resize(int iSize);
+	void Append(const Vector& vec);
+	void Clear();
+	Vector GetItem(int iIndex);
+	void SetItem(int iIndex, const Vector& vec);
+
+	Vector* GetData();
+
+	// Kernels
+	object GetDistances(const Vector& vecPoint);
+	object GetDistancesSqr(const Vector& vecPoint);
+	object Dot(const Vector& vecOther);
+	boost::shared_ptr<CVectorArray> Cross(const Vector& vecOther);
+	void Normalize();
+	boost::shared_ptr<CVectorArray> AnglesToForward();
+	void Transform(const matrix3x4_t& matrix);
+	object FindWithinBox(const Vector& vecMins, const Vector& vecMaxs);
+	object FindWithinRadius(const Vector& vecPoint, float flRadius);
+
+	// Buffer protocol
+	static int GetBuffer(PyObject* pExporter, Py_buffer* pView, int iFlags);
+	static void ReleaseBuffer(PyObject* pExporter, Py_buffer* pView);
+
+private:
+	int CheckIndex(int iIndex);
+	void CheckResizable();
+	void GetDistancesSqr(const Vector& vecPoint, float* pOutput);
+
+private:
+	std::vector<Vector>	m_Vectors;
+
+	// Buffer exports
+	int					m_iExports;
+	Py_ssize_t			m_Shape[2];
+	Py_ssize_t			m_Strides[2];
+};
+
+
+#endif // _MATHLIB_VECTOR_ARRAY_H
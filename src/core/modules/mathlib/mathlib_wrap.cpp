@@ -33,6 +33,7 @@
 #include "utilities/sp_util.h"
 #include "modules/memory/memory_tools.h"
 #include "modules/mathlib/mathlib.h"
+#include "modules/mathlib/mathlib_vector_array.h"
 
 
 //-----------------------------------------------------------------------------
@@ -44,6 +45,8 @@ void export_quaternion(scope);
 void export_cplane_t(scope);
 void export_radian_euler(scope);
 void export_matrix3x4_t(scope);
+void export_vector_array(scope);
+void export_free_list_stats(scope);
 
 
 //-----------------------------------------------------------------------------
@@ -57,6 +60,8 @@ DECLARE_SP_MODULE(_mathlib)
 	export_cplane_t(_mathlib);
 	export_radian_euler(_mathlib);
 	export_matrix3x4_t(_mathlib);
+	export_vector_array(_mathlib);
+	export_free_list_stats(_mathlib);
 }
 
 
@@ -284,6 +289,9 @@ void export_vector(scope _mathlib)
 
 		ADD_MEM_TOOLS(Vector)
 	;
+
+	// Reuse the memory of freed instances
+	CInstanceFreeList<Vector>::Install(_mathlib.attr("Vector"));
 }
 
 
@@ -375,6 +383,9 @@ void export_qangle(scope _mathlib)
 
 		ADD_MEM_TOOLS(QAngle)
 	;
+
+	// Reuse the memory of freed instances
+	CInstanceFreeList<QAngle>::Install(_mathlib.attr("QAngle"));
 }
 
 
@@ -605,3 +616,188 @@ void export_matrix3x4_t(scope _mathlib)
 		)
 	;
 }
+
+
+//-----------------------------------------------------------------------------
+// Exports CVectorArray.
+//-----------------------------------------------------------------------------
+void export_vector_array(scope _mathlib)
+{
+	class_<CVectorArray, boost::shared_ptr<CVectorArray>, boost::noncopyable> VectorArray("VectorArray", no_init);
+
+	VectorArray.def(
+		"__init__",
+		make_constructor(
+			&CVectorArray::__init__,
+			default_call_policies(),
+			(arg("data")=object())
+		),
+		"Create a new packed vector array.\n\n"
+		":param data:\n"
+		"    The number of zero vectors, an iterable of vectors or a buffer of packed float triples "
+		"(e.g. a player state view)."
+	);
+
+	VectorArray.def(
+		"__len__",
+		&CVectorArray::GetSize
+	);
+
+	VectorArray.def(
+		"__getitem__",
+		&CVectorArray::GetItem,
+		"Return a copy of the vector at the given index.\n\n"
+		":rtype: Vector",
+		args("index")
+	);
+
+	VectorArray.def(
+		"__setitem__",
+		&CVectorArray::SetItem,
+		args("index", "vector")
+	);
+
+	VectorArray.def(
+		"append",
+		&CVectorArray::Append,
+		"Append a vector.",
+		args("vector")
+	);
+
+	VectorArray.def(
+		"resize",
+		&CVectorArray::Resize,
+		"Resize the array. New vectors are zero vectors.",
+		args("size")
+	);
+
+	VectorArray.def(
+		"clear",
+		&CVectorArray::Clear,
+		"Remove all vectors."
+	);
+
+	VectorArray.def(
+		"get_distances",
+		&CVectorArray::GetDistances,
+		"Return the distance of every vector to the given point.\n\n"
+		":rtype: array",
+		args("point")
+	);
+
+	VectorArray.def(
+		"get_distances_sqr",
+		&CVectorArray::GetDistancesSqr,
+		"Return the squared distance of every vector to the given point.\n\n"
+		":rtype: array",
+		args("point")
+	);
+
+	VectorArray.def(
+		"dot",
+		&CVectorArray::Dot,
+		"Return the dot product of every vector with the given vector.\n\n"
+		":rtype: array",
+		args("other")
+	);
+
+	VectorArray.def(
+		"cross",
+		&CVectorArray::Cross,
+		"Return the cross products of every vector with the given vector.\n\n"
+		":rtype: VectorArray",
+		args("other")
+	);
+
+	VectorArray.def(
+		"normalize",
+		&CVectorArray::Normalize,
+		"Normalize every vector in place."
+	);
+
+	VectorArray.def(
+		"angles_to_forward",
+		&CVectorArray::AnglesToForward,
+		"Interpret every vector as angles and return their forward vectors.\n\n"
+		":rtype: VectorArray"
+	);
+
+	VectorArray.def(
+		"transform",
+		&CVectorArray::Transform,
+		"Transform every vector in place by the given matrix.",
+		args("matrix")
+	);
+
+	VectorArray.def(
+		"find_within_box",
+		&CVectorArray::FindWithinBox,
+		"Return the indexes of all vectors within the given box.\n\n"
+		":rtype: array",
+		args("mins", "maxs")
+	);
+
+	VectorArray.def(
+		"find_within_radius",
+		&CVectorArray::FindWithinRadius,
+		"Return the indexes of all vectors within the given radius of the point.\n\n"
+		":rtype: array",
+		args("point", "radius")
+	);
+
+	// Buffer protocol...
+	static PyBufferProcs s_BufferProcs = {
+		&CVectorArray::GetBuffer,
+		&CVectorArray::ReleaseBuffer
+	};
+	((PyTypeObject*) VectorArray.ptr())->tp_as_buffer = &s_BufferProcs;
+}
+
+
+//-----------------------------------------------------------------------------
+// Exports the instance free list statistics.
+//-----------------------------------------------------------------------------
+static dict get_free_list_stats()
+{
+	dict stats;
+	stats["Vector"] = CInstanceFreeList<Vector>::GetStats();
+	stats["QAngle"] = CInstanceFreeList<QAngle>::GetStats();
+	return stats;
+}
+
+static bool is_free_list_enabled()
+{
+	return CInstanceFreeList<Vector>::IsEnabled();
+}
+
+static void set_free_list_enabled(bool bEnabled)
+{
+	CInstanceFreeList<Vector>::SetEnabled(bEnabled);
+	CInstanceFreeList<QAngle>::SetEnabled(bEnabled);
+}
+
+void export_free_list_stats(scope _mathlib)
+{
+	def("get_free_list_stats",
+		&get_free_list_stats,
+		"Return the instance free list statistics of Vector and QAngle.\n\n"
+		":return:\n"
+		"    A dict that maps the class name to a tuple of the number of allocated instances, "
+		"the number of instances that reused freed memory and the current size of the free list.\n"
+		":rtype: dict"
+	);
+
+	def("is_free_list_enabled",
+		&is_free_list_enabled,
+		"Return whether freed Vector and QAngle instances are reused.\n\n"
+		":rtype: bool"
+	);
+
+	def("set_free_list_enabled",
+		&set_free_list_enabled,
+		"Set whether freed Vector and QAngle instances are reused. Disabling it "
+		"releases the memory kept by the free lists.\n\n"
+		":param bool enabled: Whether the free lists should be used.",
+		args("enabled")
+	);
+}
@@ -41,6 +41,219 @@ extern CSourcePython g_SourcePythonPlugin;
 extern IServerGameDLL *servergamedll;
 
 
+#ifndef USE_PROTOBUF
+//-----------------------------------------------------------------------------
+// Globals.
+//-----------------------------------------------------------------------------
+CUserMessageTable g_UserMessageTable;
+
+
+//-----------------------------------------------------------------------------
+// CUserMessageTable.
+//-----------------------------------------------------------------------------
+CUserMessageTable::CUserMessageTable():
+	m_bBuilt(false)
+{
+}
+
+void CUserMessageTable::Rebuild()
+{
+	m_Messages.clear();
+	m_Indexes.clear();
+
+	char sz_mname[256];
+	int sizereturn;
+	int index = 0;
+	while (servergamedll->GetUserMessageInfo(index, sz_mname, 255, sizereturn))
+	{
+		UserMessageInfo_t info;
+		info.m_szName = sz_mname;
+		info.m_iSize = sizereturn;
+		m_Messages.push_back(info);
+
+		// Keep the first index if a name has been registered twice
+		m_Indexes.insert(MessageNameIndexMap::value_type(info.m_szName, index));
+		index++;
+	}
+
+	m_bBuilt = true;
+}
+
+int CUserMessageTable::FindIndex(const char* szName)
+{
+	EnsureBuilt();
+
+	MessageNameIndexMap::const_iterator it = m_Indexes.find(szName, StringHashNoCase(), StringEqualNoCase());
+	if (it == m_Indexes.end())
+		return -1;
+
+	return it->second;
+}
+
+const UserMessageInfo_t* CUserMessageTable::GetInfo(int iIndex)
+{
+	EnsureBuilt();
+
+	if (iIndex < 0 || iIndex >= (int) m_Messages.size())
+		return NULL;
+
+	return &m_Messages[iIndex];
+}
+
+void CUserMessageTable::EnsureBuilt()
+{
+	// The plugin might have been loaded after ServerActivate
+	if (!m_bBuilt)
+		Rebuild();
+}
+#endif
+
+
+#ifdef USE_PROTOBUF
+//-----------------------------------------------------------------------------
+// CProtobufMessageExt.
+//-----------------------------------------------------------------------------
+void CProtobufMessageExt::SetFields(google::protobuf::Message* pMessage, dict fields)
+{
+	list items = fields.items();
+	for (int i = 0; i < len(items); i++)
+	{
+		const char* field_name = extract<const char*>(items[i][0]);
+		const google::protobuf::FieldDescriptor* field = GetFieldDescriptor(pMessage, field_name);
+		object value = items[i][1];
+
+		if (!field->is_repeated())
+		{
+			SetFieldValue(pMessage, field, value);
+			continue;
+		}
+
+		// Repeated fields are replaced as a whole
+		pMessage->GetReflection()->ClearField(pMessage, field);
+		for (int j = 0; j < len(value); j++)
+			AddFieldValue(pMessage, field, value[j]);
+	}
+}
+
+dict CProtobufMessageExt::GetFields(google::protobuf::Message* pMessage, object field_names)
+{
+	dict result;
+	for (int i = 0; i < len(field_names); i++)
+	{
+		object name = field_names[i];
+		const google::protobuf::FieldDescriptor* field = GetFieldDescriptor(pMessage, extract<const char*>(name));
+
+		if (!field->is_repeated())
+		{
+			result[name] = GetFieldValue(pMessage, field);
+			continue;
+		}
+
+		list values;
+		int size = pMessage->GetReflection()->FieldSize(*pMessage, field);
+		for (int j = 0; j < size; j++)
+			values.append(GetRepeatedFieldValue(pMessage, field, j));
+
+		result[name] = values;
+	}
+
+	return result;
+}
+
+void CProtobufMessageExt::SetFieldValue(google::protobuf::Message* pMessage, const google::protobuf::FieldDescriptor* field, object value)
+{
+	const google::protobuf::Reflection* reflection = pMessage->GetReflection();
+	switch (field->cpp_type())
+	{
+		case google::protobuf::FieldDescriptor::CPPTYPE_INT32: reflection->SetInt32(pMessage, field, extract<int32>(value)); break;
+		case google::protobuf::FieldDescriptor::CPPTYPE_INT64: reflection->SetInt64(pMessage, field, extract<int64>(value)); break;
+		case google::protobuf::FieldDescriptor::CPPTYPE_UINT32: reflection->SetUInt32(pMessage, field, extract<uint32>(value)); break;
+		case google::protobuf::FieldDescriptor::CPPTYPE_UINT64: reflection->SetUInt64(pMessage, field, extract<uint64>(value)); break;
+		case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT: reflection->SetFloat(pMessage, field, extract<float>(value)); break;
+		case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE: reflection->SetDouble(pMessage, field, extract<double>(value)); break;
+		case google::protobuf::FieldDescriptor::CPPTYPE_BOOL: reflection->SetBool(pMessage, field, extract<bool>(value)); break;
+		case google::protobuf::FieldDescriptor::CPPTYPE_STRING: reflection->SetString(pMessage, field, extract<std::string>(value)); break;
+		case google::protobuf::FieldDescriptor::CPPTYPE_ENUM:
+			reflection->SetEnum(pMessage, field, GetEnumValueDescriptor(pMessage, field->name().c_str(), extract<int>(value)));
+			break;
+		case google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE:
+			SetFields(reflection->MutableMessage(pMessage, field), extract<dict>(value));
+			break;
+		default:
+			BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Unsupported type of field '%s'.", field->name().c_str());
+	}
+}
+
+void CProtobufMessageExt::AddFieldValue(google::protobuf::Message* pMessage, const google::protobuf::FieldDescriptor* field, object value)
+{
+	const google::protobuf::Reflection* reflection = pMessage->GetReflection();
+	switch (field->cpp_type())
+	{
+		case google::protobuf::FieldDescriptor::CPPTYPE_INT32: reflection->AddInt32(pMessage, field, extract<int32>(value)); break;
+		case google::protobuf::FieldDescriptor::CPPTYPE_INT64: reflection->AddInt64(pMessage, field, extract<int64>(value)); break;
+		case google::protobuf::FieldDescriptor::CPPTYPE_UINT32: reflection->AddUInt32(pMessage, field, extract<uint32>(value)); break;
+		case google::protobuf::FieldDescriptor::CPPTYPE_UINT64: reflection->AddUInt64(pMessage, field, extract<uint64>(value)); break;
+		case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT: reflection->AddFloat(pMessage, field, extract<float>(value)); break;
+		case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE: reflection->AddDouble(pMessage, field, extract<double>(value)); break;
+		case google::protobuf::FieldDescriptor::CPPTYPE_BOOL: reflection->AddBool(pMessage, field, extract<bool>(value)); break;
+		case google::protobuf::FieldDescriptor::CPPTYPE_STRING: reflection->AddString(pMessage, field, extract<std::string>(value)); break;
+		case google::protobuf::FieldDescriptor::CPPTYPE_ENUM:
+			reflection->AddEnum(pMessage, field, GetEnumValueDescriptor(pMessage, field->name().c_str(), extract<int>(value)));
+			break;
+		case google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE:
+			SetFields(reflection->AddMessage(pMessage, field), extract<dict>(value));
+			break;
+		default:
+			BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Unsupported type of field '%s'.", field->name().c_str());
+	}
+}
+
+object CProtobufMessageExt::GetFieldValue(google::protobuf::Message* pMessage, const google::protobuf::FieldDescriptor* field)
+{
+	const google::protobuf::Reflection* reflection = pMessage->GetReflection();
+	switch (field->cpp_type())
+	{
+		case google::protobuf::FieldDescriptor::CPPTYPE_INT32: return object(reflection->GetInt32(*pMessage, field));
+		case google::protobuf::FieldDescriptor::CPPTYPE_INT64: return object(reflection->GetInt64(*pMessage, field));
+		case google::protobuf::FieldDescriptor::CPPTYPE_UINT32: return object(reflection->GetUInt32(*pMessage, field));
+		case google::protobuf::FieldDescriptor::CPPTYPE_UINT64: return object(reflection->GetUInt64(*pMessage, field));
+		case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT: return object(reflection->GetFloat(*pMessage, field));
+		case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE: return object(reflection->GetDouble(*pMessage, field));
+		case google::protobuf::FieldDescriptor::CPPTYPE_BOOL: return object(reflection->GetBool(*pMessage, field));
+		case google::protobuf::FieldDescriptor::CPPTYPE_STRING: return object(reflection->GetString(*pMessage, field));
+		case google::protobuf::FieldDescriptor::CPPTYPE_ENUM: return object(reflection->GetEnum(*pMessage, field)->number());
+		case google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE:
+			return object(ptr(reflection->MutableMessage(pMessage, field)));
+	}
+
+	BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Unsupported type of field '%s'.", field->name().c_str());
+	return object();
+}
+
+object CProtobufMessageExt::GetRepeatedFieldValue(google::protobuf::Message* pMessage, const google::protobuf::FieldDescriptor* field, int index)
+{
+	const google::protobuf::Reflection* reflection = pMessage->GetReflection();
+	switch (field->cpp_type())
+	{
+		case google::protobuf::FieldDescriptor::CPPTYPE_INT32: return object(reflection->GetRepeatedInt32(*pMessage, field, index));
+		case google::protobuf::FieldDescriptor::CPPTYPE_INT64: return object(reflection->GetRepeatedInt64(*pMessage, field, index));
+		case google::protobuf::FieldDescriptor::CPPTYPE_UINT32: return object(reflection->GetRepeatedUInt32(*pMessage, field, index));
+		case google::protobuf::FieldDescriptor::CPPTYPE_UINT64: return object(reflection->GetRepeatedUInt64(*pMessage, field, index));
+		case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT: return object(reflection->GetRepeatedFloat(*pMessage, field, index));
+		case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE: return object(reflection->GetRepeatedDouble(*pMessage, field, index));
+		case google::protobuf::FieldDescriptor::CPPTYPE_BOOL: return object(reflection->GetRepeatedBool(*pMessage, field, index));
+		case google::protobuf::FieldDescriptor::CPPTYPE_STRING: return object(reflection->GetRepeatedString(*pMessage, field, index));
+		case google::protobuf::FieldDescriptor::CPPTYPE_ENUM: return object(reflection->GetRepeatedEnum(*pMessage, field, index)->number());
+		case google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE:
+			return object(ptr(reflection->MutableRepeatedMessage(pMessage, field, index)));
+	}
+
+	BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Unsupported type of field '%s'.", field->name().c_str());
+	return object();
+}
+#endif
+
+
 //-----------------------------------------------------------------------------
 // CUserMessage.
 //-----------------------------------------------------------------------------
@@ -96,6 +309,56 @@ bool CUserMessage::IsProtobuf()
 #endif
 }
 
+//-----------------------------------------------------------------------------
+// CPreparedUserMessage.
+//-----------------------------------------------------------------------------
+CPreparedUserMessage::CPreparedUserMessage(const char* message_name)
+{
+	m_message_name = message_name;
+	m_index = ::GetMessageIndex(message_name);
+
+#ifdef USE_PROTOBUF
+	const google::protobuf::Message* message = protobuf_helpers.GetPrototype(message_name);
+	if (!message) {
+		BOOST_RAISE_EXCEPTION(PyExc_NameError, "Invalid message name: '%s'.", message_name);
+	}
+
+	m_buffer = message->New();
+#else
+	if (m_index == -1) {
+		BOOST_RAISE_EXCEPTION(PyExc_NameError, "Invalid message name: '%s'.", message_name);
+	}
+
+	m_buffer = new bf_write(m_data, sizeof(m_data));
+#endif
+}
+
+CPreparedUserMessage::~CPreparedUserMessage()
+{
+	delete m_buffer;
+}
+
+void CPreparedUserMessage::Send(IRecipientFilter& recipients)
+{
+#ifdef USE_PROTOBUF
+	engine->SendUserMessage(recipients, m_index, *m_buffer);
+#else
+	if (m_buffer->IsOverflowed()) {
+		BOOST_RAISE_EXCEPTION(PyExc_OverflowError, "The payload of '%s' exceeds %d bytes.", m_message_name.c_str(), PREPARED_MESSAGE_MAX_SIZE);
+	}
+
+	#if defined(ENGINE_LEFT4DEAD2) || defined(ENGINE_BLADE)
+		bf_write* buffer = engine->UserMessageBegin(&recipients, m_index, m_message_name.c_str());
+	#else
+		bf_write* buffer = engine->UserMessageBegin(&recipients, m_index);
+	#endif
+
+	buffer->WriteBits(m_data, m_buffer->GetNumBitsWritten());
+	engine->MessageEnd();
+#endif
+}
+
+
 //-----------------------------------------------------------------------------
 // Functions.
 //-----------------------------------------------------------------------------
@@ -109,18 +372,7 @@ int GetMessageIndex(const char* name)
 #ifdef USE_PROTOBUF
 	return protobuf_helpers.GetIndex(name);
 #else
-	char sz_mname[256];
-	int sizereturn;
-	int index = 0;
-	while (servergamedll->GetUserMessageInfo(index, sz_mname, 255, sizereturn))
-	{
-		if (V_strcasecmp(name, sz_mname) == 0)
-		{
-			return index;
-		}
-		index++;
-	}
-	return -1;
+	return g_UserMessageTable.FindIndex(name);
 #endif
 }
 
@@ -133,12 +385,11 @@ object GetMessageName(int index)
 
 	return str(name);
 #else
-	char result[256] = "";
-	int size = 0;
-	if (!servergamedll->GetUserMessageInfo(index, result, 255, size))
+	const UserMessageInfo_t* info = g_UserMessageTable.GetInfo(index);
+	if (!info)
 		return object();
 
-	return str(result);
+	return str(info->m_szName.c_str());
 #endif
 }
 
@@ -148,11 +399,10 @@ object GetMessageSize(int index)
 	BOOST_RAISE_EXCEPTION(PyExc_NotImplementedError, "")
 	return object();
 #else
-	char result[256];
-	int size;
-	if (!servergamedll->GetUserMessageInfo(index, result, 255, size))
+	const UserMessageInfo_t* info = g_UserMessageTable.GetInfo(index);
+	if (!info)
 		return object();
 
-	return object(size);
+	return object(info->m_iSize);
 #endif
 }
@@ -35,6 +35,13 @@
 
 #include "public/engine/iserverplugin.h"
 #include "bitbuf.h"
+#include "strtools.h"
+
+#include <ctype.h>
+#include <string>
+#include <vector>
+#include "boost/unordered_map.hpp"
+#include "utilities/string_hash.h"
 
 
 #ifdef USE_PROTOBUF
@@ -53,6 +60,9 @@
 	#define MESSAGE_BUFFER google::protobuf::Message
 #else
 	#define MESSAGE_BUFFER bf_write
+
+	// Maximum payload size of a bitbuf user message
+	#define PREPARED_MESSAGE_MAX_SIZE 255
 #endif
 
 
@@ -60,6 +70,13 @@
 // Classes.
 //-----------------------------------------------------------------------------
 #ifdef USE_PROTOBUF
+	//-----------------------------------------------------------------------------
+	// Caches field descriptors by message descriptor and field name.
+	//-----------------------------------------------------------------------------
+	typedef boost::unordered_map<std::string, const google::protobuf::FieldDescriptor*, StringHash, StringEqual> FieldDescriptorMap;
+	typedef boost::unordered_map<const google::protobuf::Descriptor*, FieldDescriptorMap> FieldDescriptorCache;
+
+
 	class CProtobufMessageExt
 	{
 	public:
@@ -92,13 +109,24 @@
 		{
 			const google::protobuf::Descriptor* descriptor = pMessage->GetDescriptor();
 
+			// Descriptors of generated messages live as long as the process
+			static FieldDescriptorCache s_Cache;
+			FieldDescriptorMap& fields = s_Cache[descriptor];
+
+			FieldDescriptorMap::const_iterator it = fields.find(field_name, StringHash(), StringEqual());
+			if (it != fields.end())
+				return it->second;
+
 			// For some reasons, FindFieldByName is causing a crash if the message has been initialized
 			//	by the server so let's look it up ourself...
 			for (int iCurrentIndex=0; iCurrentIndex < descriptor->field_count(); iCurrentIndex++)
 			{
 				const google::protobuf::FieldDescriptor *field_descriptor = descriptor->field(iCurrentIndex);
 				if (field_descriptor && strcmp(field_descriptor->name().c_str(), field_name) == 0)
+				{
+					fields.insert(FieldDescriptorMap::value_type(field_name, field_descriptor));
 					return field_descriptor;
+				}
 			}
 
 			BOOST_RAISE_EXCEPTION(PyExc_NameError, "Unable to find field '%s'.", field_name);
@@ -118,6 +146,25 @@
 		{
 			return pMessage->GetReflection()->FieldSize(*pMessage, GetFieldDescriptor(pMessage, field_name));
 		}
+
+
+		// ====================================================================
+		// >> Bulk access
+		// ====================================================================
+		// Sets all fields of the given dict. Nested dicts fill sub messages
+		// and lists or tuples replace repeated fields.
+		static void SetFields(google::protobuf::Message* pMessage, dict fields);
+
+		// Returns a dict that contains the values of the given fields
+		static dict GetFields(google::protobuf::Message* pMessage, object field_names);
+
+	private:
+		static void SetFieldValue(google::protobuf::Message* pMessage, const google::protobuf::FieldDescriptor* field, object value);
+		static void AddFieldValue(google::protobuf::Message* pMessage, const google::protobuf::FieldDescriptor* field, object value);
+		static object GetFieldValue(google::protobuf::Message* pMessage, const google::protobuf::FieldDescriptor* field);
+		static object GetRepeatedFieldValue(google::protobuf::Message* pMessage, const google::protobuf::FieldDescriptor* field, int index);
+
+	public:
 		
 
 		// ====================================================================
@@ -182,7 +229,7 @@
 				BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Index (%d) out of range.", index)
 			}
 
-			return (*pMessage->GetReflection().*get_repeated_field_delegate)(*pMessage, GetFieldDescriptor(pMessage, field_name), index);
+			return (*pMessage->GetReflection().*get_repeated_field_delegate)(*pMessage, descriptor, index);
 		}
 
 		static int32 GetRepeatedInt32(google::protobuf::Message* pMessage, const char* field_name, int index)
@@ -357,6 +404,48 @@
 #endif
 
 
+#ifndef USE_PROTOBUF
+	// Message names are looked up case insensitively
+	typedef boost::unordered_map<std::string, int, StringHashNoCase, StringEqualNoCase> MessageNameIndexMap;
+
+
+	//-----------------------------------------------------------------------------
+	// Cached information of a single user message.
+	//-----------------------------------------------------------------------------
+	struct UserMessageInfo_t
+	{
+		std::string	m_szName;
+		int			m_iSize;
+	};
+
+
+	//-----------------------------------------------------------------------------
+	// Maps user message names to indexes and back.
+	//-----------------------------------------------------------------------------
+	class CUserMessageTable
+	{
+	public:
+		CUserMessageTable();
+
+		// Reads all user messages from the server
+		void Rebuild();
+
+		int FindIndex(const char* szName);
+		const UserMessageInfo_t* GetInfo(int iIndex);
+
+	private:
+		void EnsureBuilt();
+
+	private:
+		bool							m_bBuilt;
+		std::vector<UserMessageInfo_t>	m_Messages;
+		MessageNameIndexMap				m_Indexes;
+	};
+
+	extern CUserMessageTable g_UserMessageTable;
+#endif
+
+
 class CUserMessage
 {
 public:
@@ -389,6 +478,39 @@ private:
 };
 
 
+//-----------------------------------------------------------------------------
+// A user message that is encoded once and can be sent multiple times.
+//-----------------------------------------------------------------------------
+class CPreparedUserMessage
+{
+public:
+	CPreparedUserMessage(const char* message_name);
+	~CPreparedUserMessage();
+
+public:
+	const char* GetMessageName()
+	{ return m_message_name.c_str(); }
+
+	int GetMessageIndex()
+	{ return m_index; }
+
+	MESSAGE_BUFFER* GetBuffer()
+	{ return m_buffer; }
+
+	// Replays the encoded payload to the given recipients
+	void Send(IRecipientFilter& recipients);
+
+private:
+	std::string m_message_name;
+	MESSAGE_BUFFER* m_buffer;
+	int m_index;
+
+#ifndef USE_PROTOBUF
+	unsigned char m_data[PREPARED_MESSAGE_MAX_SIZE];
+#endif
+};
+
+
 //-----------------------------------------------------------------------------
 // Functions.
 //-----------------------------------------------------------------------------
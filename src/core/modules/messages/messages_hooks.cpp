@@ -0,0 +1,163 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2015 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#include "messages_hooks.h"
+#include "utilities/wrap_macros.h"
+#include "utilities/call_python.h"
+
+
+#ifndef USE_PROTOBUF
+//-----------------------------------------------------------------------------
+// Globals.
+//-----------------------------------------------------------------------------
+CUserMessageHookManager g_UserMessageHookManager;
+
+
+//-----------------------------------------------------------------------------
+// CUserMessageHookManager.
+//-----------------------------------------------------------------------------
+CUserMessageHookManager::CUserMessageHookManager()
+{
+	m_pRecipients = NULL;
+	m_iCurrentIndex = -1;
+	m_pCurrentBuffer = NULL;
+}
+
+void CUserMessageHookManager::Initialize(CFunction* pBegin, CFunction* pEnd, object oRecipients, object oCallback)
+{
+	if (!pBegin->IsHookable() || !pEnd->IsHookable())
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Function is not hookable.")
+
+	// Keep a reference, so the filter stays alive as long as we use it
+	m_pRecipients = extract<MRecipientFilter*>(oRecipients);
+	m_oRecipients = oRecipients;
+	m_oCallback = oCallback;
+
+	HookFunction(pBegin, HOOKTYPE_PRE, (HookHandlerFn*) (void*) &PreUserMessageBegin);
+	HookFunction(pBegin, HOOKTYPE_POST, (HookHandlerFn*) (void*) &PostUserMessageBegin);
+	HookFunction(pEnd, HOOKTYPE_PRE, (HookHandlerFn*) (void*) &PreMessageEnd);
+}
+
+void CUserMessageHookManager::HookFunction(CFunction* pFunc, HookType_t eHookType, HookHandlerFn* pHandler)
+{
+	CHook* pHook = GetHookManager()->FindHook((void*) pFunc->m_ulAddr);
+	if (!pHook)
+	{
+		pHook = GetHookManager()->HookFunction((void*) pFunc->m_ulAddr, pFunc->m_pCallingConvention);
+		if (!pHook)
+			BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Could not create a hook.")
+	}
+
+	// It won't be added twice if the module has been reloaded
+	pHook->AddCallback(eHookType, pHandler);
+}
+
+bool CUserMessageHookManager::IsHooked(int iIndex)
+{
+	if (iIndex < 0 || iIndex >= USER_MESSAGE_HOOK_LIMIT)
+		return false;
+
+	return m_Hooked.IsBitSet(iIndex);
+}
+
+void CUserMessageHookManager::SetHooked(int iIndex, bool bHooked)
+{
+	if (iIndex < 0 || iIndex >= USER_MESSAGE_HOOK_LIMIT)
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid message index: %d.", iIndex)
+
+	if (bHooked)
+		m_Hooked.Set(iIndex);
+	else
+		m_Hooked.Clear(iIndex);
+}
+
+bool CUserMessageHookManager::PreUserMessageBegin(HookType_t eHookType, CHook* pHook)
+{
+	CUserMessageHookManager& manager = g_UserMessageHookManager;
+	int iIndex = pHook->GetArgument<int>(2);
+
+	if (!manager.m_pRecipients || !manager.IsHooked(iIndex))
+	{
+		manager.m_iCurrentIndex = -1;
+		return false;
+	}
+
+	// Replace the original filter, so hooks are able to modify the recipients
+	IRecipientFilter* pFilter = pHook->GetArgument<IRecipientFilter*>(1);
+	if (pFilter != manager.m_pRecipients)
+	{
+		// Patch for issue #314: calling the virtual functions of some game
+		// filters crashes. Their members match the ones of MRecipientFilter
+		// (which mirrors CRecipientFilter), so copy them without using the
+		// vtable of the game's filter.
+		MRecipientFilter* pGameFilter = (MRecipientFilter *) pFilter;
+
+		manager.m_pRecipients->RemoveAllPlayers();
+		for (int i=0; i < pGameFilter->m_Recipients.Count(); i++)
+			manager.m_pRecipients->AddRecipient(pGameFilter->m_Recipients[i]);
+
+		manager.m_pRecipients->m_bReliable = pGameFilter->m_bReliable;
+		manager.m_pRecipients->m_bInitMessage = pGameFilter->m_bInitMessage;
+		pHook->SetArgument<IRecipientFilter*>(1, manager.m_pRecipients);
+	}
+
+	manager.m_iCurrentIndex = iIndex;
+	return false;
+}
+
+bool CUserMessageHookManager::PostUserMessageBegin(HookType_t eHookType, CHook* pHook)
+{
+	CUserMessageHookManager& manager = g_UserMessageHookManager;
+	if (manager.m_iCurrentIndex != -1)
+		manager.m_pCurrentBuffer = pHook->GetReturnValue<bf_write*>();
+
+	return false;
+}
+
+bool CUserMessageHookManager::PreMessageEnd(HookType_t eHookType, CHook* pHook)
+{
+	CUserMessageHookManager& manager = g_UserMessageHookManager;
+
+	// This happens if the message hasn't been hooked or if the hooks have
+	// been initialized while a message was being written
+	if (manager.m_iCurrentIndex == -1 || !manager.m_pCurrentBuffer)
+		return false;
+
+	int iIndex = manager.m_iCurrentIndex;
+	bf_write* pBuffer = manager.m_pCurrentBuffer;
+	manager.m_iCurrentIndex = -1;
+	manager.m_pCurrentBuffer = NULL;
+
+	BEGIN_BOOST_PY()
+		manager.m_oCallback(iIndex, manager.m_oRecipients, ptr(pBuffer));
+	END_BOOST_PY_NORET()
+
+	return false;
+}
+#endif
@@ -0,0 +1,95 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2015 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+#ifndef _MESSAGES_HOOKS_H
+#define _MESSAGES_HOOKS_H
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+// DynamicHooks
+#include "hook.h"
+
+// Boost.Python
+#include "boost/python.hpp"
+using namespace boost::python;
+
+// SDK
+#include "bitvec.h"
+#include "bitbuf.h"
+
+// Source.Python
+#include "modules/filters/filters_recipients.h"
+#include "modules/memory/memory_function.h"
+
+
+//-----------------------------------------------------------------------------
+// Constants.
+//-----------------------------------------------------------------------------
+// Bitbuf games send the message index as a byte
+#define USER_MESSAGE_HOOK_LIMIT 256
+
+
+#ifndef USE_PROTOBUF
+//-----------------------------------------------------------------------------
+// Intercepts UserMessageBegin and MessageEnd, but only enters Python for
+// message indexes that have been marked as hooked.
+//-----------------------------------------------------------------------------
+class CUserMessageHookManager
+{
+public:
+	CUserMessageHookManager();
+
+	void Initialize(CFunction* pBegin, CFunction* pEnd, object oRecipients, object oCallback);
+
+	bool IsHooked(int iIndex);
+	void SetHooked(int iIndex, bool bHooked);
+
+	// Hook handlers
+	static bool PreUserMessageBegin(HookType_t eHookType, CHook* pHook);
+	static bool PostUserMessageBegin(HookType_t eHookType, CHook* pHook);
+	static bool PreMessageEnd(HookType_t eHookType, CHook* pHook);
+
+private:
+	static void HookFunction(CFunction* pFunc, HookType_t eHookType, HookHandlerFn* pHandler);
+
+private:
+	CBitVec<USER_MESSAGE_HOOK_LIMIT>	m_Hooked;
+	MRecipientFilter*					m_pRecipients;
+	object								m_oRecipients;
+	object								m_oCallback;
+
+	// The hooked message that is currently being written
+	int									m_iCurrentIndex;
+	bf_write*							m_pCurrentBuffer;
+};
+
+extern CUserMessageHookManager g_UserMessageHookManager;
+#endif
+
+
+#endif // _MESSAGES_HOOKS_H
@@ -32,6 +32,7 @@
 using namespace boost::python;
 
 #include "messages.h"
+#include "messages_hooks.h"
 #include "shake.h"
 #include "shareddefs.h"
 
@@ -42,6 +43,8 @@ using namespace boost::python;
 void export_message_functions(scope);
 void export_dialog_enum(scope);
 void export_user_message(scope);
+void export_prepared_user_message(scope);
+void export_user_message_hook_manager(scope);
 void export_protobuf_message(scope);
 void export_shake_command(scope);
 void export_hud_destination(scope);
@@ -53,6 +56,8 @@ DECLARE_SP_MODULE(_messages)
 	export_message_functions(_messages);
 	export_dialog_enum(_messages);
 	export_user_message(_messages);
+	export_prepared_user_message(_messages);
+	export_user_message_hook_manager(_messages);
 	export_protobuf_message(_messages);
 	export_shake_command(_messages);
 	export_hud_destination(_messages);
@@ -96,6 +101,104 @@ void export_user_message(scope _message)
 }
 
 
+//-----------------------------------------------------------------------------
+// Exposes the PreparedUserMessage class
+//-----------------------------------------------------------------------------
+void export_prepared_user_message(scope _messages)
+{
+	class_<CPreparedUserMessage, boost::noncopyable> PreparedUserMessage(
+		"PreparedUserMessage",
+		"A user message that is encoded once and can be sent multiple times.",
+		init<const char*>(
+			args("message_name"),
+			"Initialize the prepared user message.\n\n"
+			":param str message_name:\n"
+			"    The name of the user message.\n"
+			":raise NameError:\n"
+			"    Raised if the user message does not exist."
+		)
+	);
+
+	PreparedUserMessage.add_property("message_name",
+		&CPreparedUserMessage::GetMessageName
+	);
+
+	PreparedUserMessage.add_property("message_index",
+		&CPreparedUserMessage::GetMessageIndex
+	);
+
+	PreparedUserMessage.add_property("buffer",
+		make_function(&CPreparedUserMessage::GetBuffer, reference_existing_object_policy()),
+		"Return the buffer that stores the payload.\n\n"
+		":rtype: BitBufferWrite/ProtobufMessage"
+	);
+
+	PreparedUserMessage.def("send",
+		&CPreparedUserMessage::Send,
+		"Send the encoded payload to the given recipients.\n\n"
+		":param IRecipientFilter recipients:\n"
+		"    The players that should receive the user message.",
+		args("recipients")
+	);
+
+	PreparedUserMessage.def("is_protobuf",
+		&CUserMessage::IsProtobuf
+	).staticmethod("is_protobuf");
+
+	PreparedUserMessage ADD_MEM_TOOLS(CPreparedUserMessage);
+}
+
+
+//-----------------------------------------------------------------------------
+// Exposes CUserMessageHookManager
+//-----------------------------------------------------------------------------
+void export_user_message_hook_manager(scope _messages)
+{
+#ifndef USE_PROTOBUF
+	class_<CUserMessageHookManager, boost::noncopyable> UserMessageHookManager("UserMessageHookManager", no_init);
+
+	UserMessageHookManager.def(
+		"initialize",
+		&CUserMessageHookManager::Initialize,
+		"Hook UserMessageBegin and MessageEnd.\n\n"
+		":param Function begin:\n"
+		"    The UserMessageBegin function.\n"
+		":param Function end:\n"
+		"    The MessageEnd function.\n"
+		":param RecipientFilter recipients:\n"
+		"    The filter that replaces the recipients of hooked messages.\n"
+		":param callback:\n"
+		"    Called with the message index, the recipients and the buffer\n"
+		"    before a hooked message is sent.",
+		args("begin", "end", "recipients", "callback")
+	);
+
+	UserMessageHookManager.def(
+		"is_hooked",
+		&CUserMessageHookManager::IsHooked,
+		"Return whether the given message index is hooked.\n\n"
+		":param int index:\n"
+		"    The message index.\n"
+		":rtype: bool",
+		args("index")
+	);
+
+	UserMessageHookManager.def(
+		"set_hooked",
+		&CUserMessageHookManager::SetHooked,
+		"Set whether the callback is called for the given message index.\n\n"
+		":param int index:\n"
+		"    The message index.\n"
+		":param bool hooked:\n"
+		"    Whether the message index is hooked.",
+		args("index", "hooked")
+	);
+
+	_messages.attr("user_message_hook_manager") = object(ptr(&g_UserMessageHookManager));
+#endif
+}
+
+
 //-----------------------------------------------------------------------------
 // Exposes CProtobufMessage
 //-----------------------------------------------------------------------------
@@ -169,6 +272,27 @@ void export_protobuf_message(scope _messages)
 		"Return the number of elements of a repeated field.\n\n"
 		":rtype: int");
 
+	ProtobufMessage.def(
+		"set_fields",
+		&CProtobufMessageExt::SetFields,
+		"Set multiple fields in one call.\n\n"
+		":param dict fields:\n"
+		"    The field names and their values. A dict sets the fields of a\n"
+		"    sub message and a list or tuple replaces a repeated field.",
+		args("fields"));
+
+	ProtobufMessage.def(
+		"get_fields",
+		&CProtobufMessageExt::GetFields,
+		"Return the values of multiple fields.\n\n"
+		":param tuple field_names:\n"
+		"    The names of the fields.\n"
+		":return:\n"
+		"    A dict that maps the field names to their values. Repeated fields\n"
+		"    are returned as a list.\n"
+		":rtype: dict",
+		args("field_names"));
+
 	ProtobufMessage.def(
 		"clear",
 		&google::protobuf::Message::Clear,
@@ -440,6 +440,11 @@ Vector PlayerMixin::GetViewVector()
 	return Vector(cp * cy, cp * sy, -sp);
 }
 
+void PlayerMixin::GetViewVectorInto(Vector& output)
+{
+	output = GetViewVector();
+}
+
 void PlayerMixin::SetViewVector(Vector& value)
 {
 	BOOST_RAISE_EXCEPTION(PyExc_NotImplementedError, "Setting view_vector is not implemented.");
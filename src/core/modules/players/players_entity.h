@@ -160,6 +160,7 @@ public:
 	void SetEyeAngle(QAngle& value);
 
 	Vector GetViewVector();
+	void GetViewVectorInto(Vector& output);
 	void SetViewVector(Vector& value);
 
 	QAngle GetViewAngle();
@@ -32,14 +32,18 @@
 #include "edict.h"
 #include "boost/python/iterator.hpp"
 #include "utilities/conversions.h"
+#include "game/server/iplayerinfo.h"
+#include "players_entity.h"
 
 
 //-----------------------------------------------------------------------------
 // CPlayerGenerator Constructor.
 //-----------------------------------------------------------------------------
-CPlayerGenerator::CPlayerGenerator( PyObject* self ):
+CPlayerGenerator::CPlayerGenerator( PyObject* self, unsigned int uiIsMask, unsigned int uiNotMask ):
 	IPythonGenerator<edict_t>(self),
-	m_iEntityIndex(0)
+	m_iEntityIndex(0),
+	m_uiIsMask(uiIsMask),
+	m_uiNotMask(uiNotMask)
 {
 }
 
@@ -49,7 +53,9 @@ CPlayerGenerator::CPlayerGenerator( PyObject* self ):
 //-----------------------------------------------------------------------------
 CPlayerGenerator::CPlayerGenerator( PyObject* self, const CPlayerGenerator& rhs ):
 	IPythonGenerator<edict_t>(self),
-	m_iEntityIndex(rhs.m_iEntityIndex)
+	m_iEntityIndex(rhs.m_iEntityIndex),
+	m_uiIsMask(rhs.m_uiIsMask),
+	m_uiNotMask(rhs.m_uiNotMask)
 {
 }
 
@@ -63,16 +69,47 @@ CPlayerGenerator::~CPlayerGenerator()
 
 
 //-----------------------------------------------------------------------------
-// Returns the next valid edict_t instance.
+// Returns the next valid edict_t instance that matches the filter masks.
 //-----------------------------------------------------------------------------
 edict_t *CPlayerGenerator::getNext()
 {
-	edict_t* pEdict = NULL;
+	edict_t* pEdict;
 	while(m_iEntityIndex < gpGlobals->maxClients)
 	{
 		m_iEntityIndex++;
-		if (EdictFromIndex(m_iEntityIndex, pEdict))
-			break;
+		if (!EdictFromIndex(m_iEntityIndex, pEdict))
+			continue;
+
+		if (!m_uiIsMask && !m_uiNotMask)
+			return pEdict;
+
+		unsigned int uiMask;
+		if (GetPlayerFilterMask(m_iEntityIndex, uiMask) && MatchesPlayerFilterMask(uiMask, m_uiIsMask, m_uiNotMask))
+			return pEdict;
 	}
-	return pEdict;
+	return NULL;
+}
+
+
+//-----------------------------------------------------------------------------
+// Returns the filter mask of the given player index.
+//-----------------------------------------------------------------------------
+bool GetPlayerFilterMask(unsigned int uiIndex, unsigned int& output)
+{
+	IPlayerInfo* pInfo;
+	if (!PlayerInfoFromIndex(uiIndex, pInfo))
+		return false;
+
+	CBaseEntity* pBaseEntity;
+	if (!BaseEntityFromIndex(uiIndex, pBaseEntity))
+		return false;
+
+	// Use the same checks as Player.is_bot(), Player.dead and Player.team
+	PlayerMixin* pPlayer = (PlayerMixin*) pBaseEntity;
+	bool bBot = pInfo->IsFakeClient() || V_strcmp(pInfo->GetNetworkIDString(), "BOT") == 0;
+
+	output = bBot ? PLAYER_FILTER_BOT : PLAYER_FILTER_HUMAN;
+	output |= pPlayer->GetDead() ? PLAYER_FILTER_DEAD : PLAYER_FILTER_ALIVE;
+	output |= GetTeamFilterMask(pPlayer->GetTeamIndex());
+	return true;
 }
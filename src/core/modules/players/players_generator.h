@@ -35,13 +35,46 @@
 #include "edict.h"
 
 
+//-----------------------------------------------------------------------------
+// Player filter masks.
+//
+// A player matches a pair of masks if it has all bits of the "is" mask and
+// none of the bits of the "not" mask.
+//-----------------------------------------------------------------------------
+enum PlayerFilterMask
+{
+	PLAYER_FILTER_HUMAN	= (1 << 0),
+	PLAYER_FILTER_BOT	= (1 << 1),
+	PLAYER_FILTER_ALIVE	= (1 << 2),
+	PLAYER_FILTER_DEAD	= (1 << 3)
+};
+
+#define PLAYER_FILTER_TEAM_SHIFT 4
+#define PLAYER_FILTER_MAX_TEAMS (32 - PLAYER_FILTER_TEAM_SHIFT)
+
+inline unsigned int GetTeamFilterMask(int iTeam)
+{
+	if (iTeam < 0 || iTeam >= PLAYER_FILTER_MAX_TEAMS)
+		return 0;
+
+	return 1 << (PLAYER_FILTER_TEAM_SHIFT + iTeam);
+}
+
+inline bool MatchesPlayerFilterMask(unsigned int uiMask, unsigned int uiIsMask, unsigned int uiNotMask)
+{
+	return (uiMask & uiIsMask) == uiIsMask && (uiMask & uiNotMask) == 0;
+}
+
+bool GetPlayerFilterMask(unsigned int uiIndex, unsigned int& output);
+
+
 //-----------------------------------------------------------------------------
 // Declare the generator class.
 //-----------------------------------------------------------------------------
 class CPlayerGenerator: public IPythonGenerator<edict_t>
 {
 public:
-	CPlayerGenerator(PyObject* self);
+	CPlayerGenerator(PyObject* self, unsigned int uiIsMask=0, unsigned int uiNotMask=0);
 	CPlayerGenerator(PyObject* self, const CPlayerGenerator& rhs);
 	virtual ~CPlayerGenerator();
 
@@ -50,6 +83,8 @@ protected:
 
 private:
 	int m_iEntityIndex;
+	unsigned int m_uiIsMask;
+	unsigned int m_uiNotMask;
 };
 
 BOOST_SPECIALIZE_HAS_BACK_REFERENCE(CPlayerGenerator)
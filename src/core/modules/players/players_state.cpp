@@ -0,0 +1,281 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2015 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#include "players_state.h"
+#include "players_entity.h"
+#include "players_generator.h"
+#include "utilities/conversions.h"
+#include "game/server/iplayerinfo.h"
+#include "strtools.h"
+
+
+//-----------------------------------------------------------------------------
+// External variables.
+//-----------------------------------------------------------------------------
+extern IVEngineServer* engine;
+extern CGlobalVars* gpGlobals;
+
+
+//-----------------------------------------------------------------------------
+// Global player state table.
+//-----------------------------------------------------------------------------
+CPlayerStateTable g_PlayerStateTable;
+
+
+//-----------------------------------------------------------------------------
+// CPlayerStateTable.
+//-----------------------------------------------------------------------------
+CPlayerStateTable::CPlayerStateTable()
+{
+	m_iTick = -1;
+	for (unsigned int i=0; i < PLAYER_STATE_SLOTS; ++i)
+		ClearSlot(i);
+}
+
+void CPlayerStateTable::Update()
+{
+	if (m_iTick != gpGlobals->tickcount)
+		ForceUpdate();
+}
+
+void CPlayerStateTable::ForceUpdate()
+{
+	m_iTick = gpGlobals->tickcount;
+	for (unsigned int i=1; i <= (unsigned int) gpGlobals->maxClients; ++i)
+		UpdateSlot(i);
+}
+
+void CPlayerStateTable::Invalidate()
+{
+	m_iTick = -1;
+}
+
+void CPlayerStateTable::UpdateSlot(unsigned int uiIndex)
+{
+	m_ucConnected[uiIndex] = 0;
+	m_ucAlive[uiIndex] = 0;
+	m_ucBot[uiIndex] = 0;
+	m_iTeam[uiIndex] = 0;
+	m_iUserID[uiIndex] = INVALID_PLAYER_USERID;
+	m_uiFilterMask[uiIndex] = 0;
+	m_szSteamID[uiIndex][0] = '\0';
+
+	IPlayerInfo* pInfo;
+	if (!PlayerInfoFromIndex(uiIndex, pInfo) || !pInfo->IsConnected())
+		return;
+
+	CBaseEntity* pBaseEntity;
+	if (!BaseEntityFromIndex(uiIndex, pBaseEntity))
+		return;
+
+	PlayerMixin* pPlayer = (PlayerMixin*) pBaseEntity;
+	const char* szSteamID = pInfo->GetNetworkIDString();
+
+	m_ucConnected[uiIndex] = 1;
+	m_ucAlive[uiIndex] = !pPlayer->GetDead();
+	m_ucBot[uiIndex] = pInfo->IsFakeClient() || V_strcmp(szSteamID, "BOT") == 0;
+	m_iTeam[uiIndex] = pPlayer->GetTeamIndex();
+	m_iUserID[uiIndex] = pInfo->GetUserID();
+	V_strncpy(m_szSteamID[uiIndex], szSteamID, PLAYER_STATE_STRING_LENGTH);
+
+	m_uiFilterMask[uiIndex] = m_ucBot[uiIndex] ? PLAYER_FILTER_BOT : PLAYER_FILTER_HUMAN;
+	m_uiFilterMask[uiIndex] |= m_ucAlive[uiIndex] ? PLAYER_FILTER_ALIVE : PLAYER_FILTER_DEAD;
+	m_uiFilterMask[uiIndex] |= GetTeamFilterMask(m_iTeam[uiIndex]);
+
+	Vector vecOrigin = pInfo->GetAbsOrigin();
+	m_fOrigin[uiIndex][0] = vecOrigin.x;
+	m_fOrigin[uiIndex][1] = vecOrigin.y;
+	m_fOrigin[uiIndex][2] = vecOrigin.z;
+
+	QAngle angEyeAngles = pPlayer->GetEyeAngle();
+	m_fEyeAngles[uiIndex][0] = angEyeAngles.x;
+	m_fEyeAngles[uiIndex][1] = angEyeAngles.y;
+	m_fEyeAngles[uiIndex][2] = angEyeAngles.z;
+}
+
+void CPlayerStateTable::UpdateLanguage(unsigned int uiIndex)
+{
+	if (uiIndex == WORLD_ENTITY_INDEX || uiIndex >= PLAYER_STATE_SLOTS)
+		return;
+
+	IPlayerInfo* pInfo;
+	if (!PlayerInfoFromIndex(uiIndex, pInfo) || pInfo->IsFakeClient())
+		return;
+
+	// Not every game returns cl_language here. Those games query it and
+	// pass the result to SetLanguage().
+	const char* szLanguage = engine->GetClientConVarValue(uiIndex, "cl_language");
+	if (szLanguage && *szLanguage)
+		SetLanguage(uiIndex, szLanguage);
+}
+
+void CPlayerStateTable::SetLanguage(unsigned int uiIndex, const char* szLanguage)
+{
+	if (uiIndex == WORLD_ENTITY_INDEX || uiIndex >= PLAYER_STATE_SLOTS)
+		return;
+
+	V_strncpy(m_szLanguage[uiIndex], szLanguage, PLAYER_STATE_STRING_LENGTH);
+}
+
+void CPlayerStateTable::ClearSlot(unsigned int uiIndex)
+{
+	if (uiIndex >= PLAYER_STATE_SLOTS)
+		return;
+
+	m_ucConnected[uiIndex] = 0;
+	m_ucAlive[uiIndex] = 0;
+	m_ucBot[uiIndex] = 0;
+	m_iTeam[uiIndex] = 0;
+	m_iUserID[uiIndex] = INVALID_PLAYER_USERID;
+	m_uiFilterMask[uiIndex] = 0;
+	m_szSteamID[uiIndex][0] = '\0';
+	m_szLanguage[uiIndex][0] = '\0';
+
+	for (int i=0; i < 3; ++i)
+	{
+		m_fOrigin[uiIndex][i] = 0;
+		m_fEyeAngles[uiIndex][i] = 0;
+	}
+}
+
+int CPlayerStateTable::GetTick()
+{
+	return m_iTick;
+}
+
+void CPlayerStateTable::CheckIndex(unsigned int uiIndex)
+{
+	if (uiIndex == WORLD_ENTITY_INDEX || uiIndex > (unsigned int) gpGlobals->maxClients)
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid player index: %u", uiIndex)
+
+	Update();
+}
+
+bool CPlayerStateTable::IsConnected(unsigned int uiIndex)
+{
+	CheckIndex(uiIndex);
+	return m_ucConnected[uiIndex] != 0;
+}
+
+bool CPlayerStateTable::IsAlive(unsigned int uiIndex)
+{
+	CheckIndex(uiIndex);
+	return m_ucAlive[uiIndex] != 0;
+}
+
+bool CPlayerStateTable::IsBot(unsigned int uiIndex)
+{
+	CheckIndex(uiIndex);
+	return m_ucBot[uiIndex] != 0;
+}
+
+int CPlayerStateTable::GetTeam(unsigned int uiIndex)
+{
+	CheckIndex(uiIndex);
+	return m_iTeam[uiIndex];
+}
+
+int CPlayerStateTable::GetUserID(unsigned int uiIndex)
+{
+	CheckIndex(uiIndex);
+	return m_iUserID[uiIndex];
+}
+
+unsigned int CPlayerStateTable::GetFilterMask(unsigned int uiIndex)
+{
+	CheckIndex(uiIndex);
+	return m_uiFilterMask[uiIndex];
+}
+
+const char* CPlayerStateTable::GetSteamID(unsigned int uiIndex)
+{
+	CheckIndex(uiIndex);
+	return m_szSteamID[uiIndex];
+}
+
+const char* CPlayerStateTable::GetLanguage(unsigned int uiIndex)
+{
+	CheckIndex(uiIndex);
+	return m_szLanguage[uiIndex];
+}
+
+Vector CPlayerStateTable::GetOrigin(unsigned int uiIndex)
+{
+	CheckIndex(uiIndex);
+	return Vector(m_fOrigin[uiIndex][0], m_fOrigin[uiIndex][1], m_fOrigin[uiIndex][2]);
+}
+
+QAngle CPlayerStateTable::GetEyeAngles(unsigned int uiIndex)
+{
+	CheckIndex(uiIndex);
+	return QAngle(m_fEyeAngles[uiIndex][0], m_fEyeAngles[uiIndex][1], m_fEyeAngles[uiIndex][2]);
+}
+
+object CPlayerStateTable::GetView(PlayerStateField field)
+{
+	Update();
+
+	void* pData = NULL;
+	Py_ssize_t size = 0;
+	const char* szFormat = "B";
+	int iColumns = 1;
+
+	switch (field)
+	{
+		case PLAYER_STATE_CONNECTED:
+			pData = m_ucConnected; size = sizeof(m_ucConnected); break;
+		case PLAYER_STATE_ALIVE:
+			pData = m_ucAlive; size = sizeof(m_ucAlive); break;
+		case PLAYER_STATE_BOT:
+			pData = m_ucBot; size = sizeof(m_ucBot); break;
+		case PLAYER_STATE_TEAM:
+			pData = m_iTeam; size = sizeof(m_iTeam); szFormat = "i"; break;
+		case PLAYER_STATE_USERID:
+			pData = m_iUserID; size = sizeof(m_iUserID); szFormat = "i"; break;
+		case PLAYER_STATE_FILTER_MASK:
+			pData = m_uiFilterMask; size = sizeof(m_uiFilterMask); szFormat = "I"; break;
+		case PLAYER_STATE_ORIGIN:
+			pData = m_fOrigin; size = sizeof(m_fOrigin); szFormat = "f"; iColumns = 3; break;
+		case PLAYER_STATE_EYE_ANGLES:
+			pData = m_fEyeAngles; size = sizeof(m_fEyeAngles); szFormat = "f"; iColumns = 3; break;
+		default:
+			BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Invalid field: %i", (int) field)
+	}
+
+	PyObject* pView = PyMemoryView_FromMemory((char*) pData, size, PyBUF_READ);
+	if (!pView)
+		throw_error_already_set();
+
+	object view = object(handle<>(pView));
+	if (iColumns == 1)
+		return view.attr("cast")(szFormat);
+
+	return view.attr("cast")(szFormat, make_tuple(PLAYER_STATE_SLOTS, iColumns));
+}
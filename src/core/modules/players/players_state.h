@@ -0,0 +1,123 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2015 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+#ifndef _PLAYERS_STATE_H
+#define _PLAYERS_STATE_H
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#include "boost/python.hpp"
+using namespace boost::python;
+
+#include "const.h"
+#include "mathlib/vector.h"
+
+
+//-----------------------------------------------------------------------------
+// Constants.
+//-----------------------------------------------------------------------------
+#define PLAYER_STATE_SLOTS (ABSOLUTE_PLAYER_LIMIT + 1)
+#define PLAYER_STATE_STRING_LENGTH 64
+
+
+//-----------------------------------------------------------------------------
+// Fields that can be viewed as a buffer.
+//-----------------------------------------------------------------------------
+enum PlayerStateField
+{
+	PLAYER_STATE_CONNECTED,
+	PLAYER_STATE_ALIVE,
+	PLAYER_STATE_BOT,
+	PLAYER_STATE_TEAM,
+	PLAYER_STATE_USERID,
+	PLAYER_STATE_FILTER_MASK,
+	PLAYER_STATE_ORIGIN,
+	PLAYER_STATE_EYE_ANGLES
+};
+
+
+//-----------------------------------------------------------------------------
+// Struct-of-arrays snapshot of all players, indexed by player index.
+//
+// The snapshot is taken at the start of every server frame, or by the first
+// access of a tick if that happens earlier. Every access during the same
+// tick returns the same values.
+//-----------------------------------------------------------------------------
+class CPlayerStateTable
+{
+public:
+	CPlayerStateTable();
+
+	void Update();
+	void ForceUpdate();
+	void Invalidate();
+
+	void UpdateLanguage(unsigned int uiIndex);
+	void SetLanguage(unsigned int uiIndex, const char* szLanguage);
+	void ClearSlot(unsigned int uiIndex);
+
+	int GetTick();
+
+	bool IsConnected(unsigned int uiIndex);
+	bool IsAlive(unsigned int uiIndex);
+	bool IsBot(unsigned int uiIndex);
+	int GetTeam(unsigned int uiIndex);
+	int GetUserID(unsigned int uiIndex);
+	unsigned int GetFilterMask(unsigned int uiIndex);
+	const char* GetSteamID(unsigned int uiIndex);
+	const char* GetLanguage(unsigned int uiIndex);
+	Vector GetOrigin(unsigned int uiIndex);
+	QAngle GetEyeAngles(unsigned int uiIndex);
+
+	object GetView(PlayerStateField field);
+
+private:
+	void UpdateSlot(unsigned int uiIndex);
+	void CheckIndex(unsigned int uiIndex);
+
+private:
+	int				m_iTick;
+
+	unsigned char	m_ucConnected[PLAYER_STATE_SLOTS];
+	unsigned char	m_ucAlive[PLAYER_STATE_SLOTS];
+	unsigned char	m_ucBot[PLAYER_STATE_SLOTS];
+	int				m_iTeam[PLAYER_STATE_SLOTS];
+	int				m_iUserID[PLAYER_STATE_SLOTS];
+	unsigned int	m_uiFilterMask[PLAYER_STATE_SLOTS];
+	float			m_fOrigin[PLAYER_STATE_SLOTS][3];
+	float			m_fEyeAngles[PLAYER_STATE_SLOTS][3];
+	char			m_szSteamID[PLAYER_STATE_SLOTS][PLAYER_STATE_STRING_LENGTH];
+
+	// Not part of the snapshot. Updated when the client's settings change.
+	char			m_szLanguage[PLAYER_STATE_SLOTS][PLAYER_STATE_STRING_LENGTH];
+};
+
+extern CPlayerStateTable g_PlayerStateTable;
+
+
+#endif // _PLAYERS_STATE_H
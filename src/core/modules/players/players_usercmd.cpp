@@ -0,0 +1,218 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2015 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#include <algorithm>
+#include "players_usercmd.h"
+#include "utilities/wrap_macros.h"
+#include "game/shared/usercmd.h"
+#include "mathlib/mathlib.h"
+
+
+//-----------------------------------------------------------------------------
+// Global rule manager.
+//-----------------------------------------------------------------------------
+CUserCmdRuleManager g_UserCmdRuleManager;
+
+
+//-----------------------------------------------------------------------------
+// Helper functions.
+//-----------------------------------------------------------------------------
+inline float ClampValue(float fValue, float fMin, float fMax)
+{
+	// Malformed values must not slip through the comparisons below
+	if (!IsFinite(fValue))
+	{
+		if (fValue > 0)
+			return fMax;
+
+		if (fValue < 0)
+			return fMin;
+
+		return (fMin <= 0 && fMax >= 0) ? 0 : fMin;
+	}
+
+	if (fValue < fMin)
+		return fMin;
+
+	if (fValue > fMax)
+		return fMax;
+
+	return fValue;
+}
+
+
+//-----------------------------------------------------------------------------
+// CUserCmdRule.
+//-----------------------------------------------------------------------------
+CUserCmdRule::CUserCmdRule(UserCmdRuleType type)
+{
+	m_Type = type;
+	m_iButtons = 0;
+	m_Field = USERCMD_RULE_PITCH;
+	m_fMin = 0;
+	m_fMax = 0;
+	m_Players.SetAll();
+}
+
+void CUserCmdRule::Apply(CUserCmd* pCmd)
+{
+	if (m_Type == USERCMD_RULE_BUTTON_MASK)
+	{
+		pCmd->buttons &= ~m_iButtons;
+		return;
+	}
+
+	switch (m_Field)
+	{
+		case USERCMD_RULE_PITCH:
+			pCmd->viewangles.x = ClampValue(pCmd->viewangles.x, m_fMin, m_fMax); break;
+		case USERCMD_RULE_YAW:
+			pCmd->viewangles.y = ClampValue(pCmd->viewangles.y, m_fMin, m_fMax); break;
+		case USERCMD_RULE_ROLL:
+			pCmd->viewangles.z = ClampValue(pCmd->viewangles.z, m_fMin, m_fMax); break;
+		case USERCMD_RULE_FORWARD_MOVE:
+			pCmd->forwardmove = ClampValue(pCmd->forwardmove, m_fMin, m_fMax); break;
+		case USERCMD_RULE_SIDE_MOVE:
+			pCmd->sidemove = ClampValue(pCmd->sidemove, m_fMin, m_fMax); break;
+		case USERCMD_RULE_UP_MOVE:
+			pCmd->upmove = ClampValue(pCmd->upmove, m_fMin, m_fMax); break;
+		case USERCMD_RULE_MOUSE_DX:
+			pCmd->mousedx = (short) ClampValue(pCmd->mousedx, m_fMin, m_fMax); break;
+		case USERCMD_RULE_MOUSE_DY:
+			pCmd->mousedy = (short) ClampValue(pCmd->mousedy, m_fMin, m_fMax); break;
+	}
+}
+
+float CUserCmdRule::GetMin()
+{
+	return m_fMin;
+}
+
+void CUserCmdRule::SetMin(float fMin)
+{
+	SetRange(fMin, m_fMax);
+}
+
+float CUserCmdRule::GetMax()
+{
+	return m_fMax;
+}
+
+void CUserCmdRule::SetMax(float fMax)
+{
+	SetRange(m_fMin, fMax);
+}
+
+void CUserCmdRule::SetRange(float fMin, float fMax)
+{
+	if (!IsFinite(fMin) || !IsFinite(fMax))
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Minimum and maximum must be finite.")
+
+	if (fMin > fMax)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Minimum (%f) is greater than maximum (%f).", fMin, fMax)
+
+	m_fMin = fMin;
+	m_fMax = fMax;
+}
+
+bool CUserCmdRule::IsEnabled(unsigned int uiIndex)
+{
+	if (uiIndex > ABSOLUTE_PLAYER_LIMIT)
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid player index: %u", uiIndex)
+
+	return m_Players.IsBitSet(uiIndex);
+}
+
+void CUserCmdRule::SetEnabled(unsigned int uiIndex, bool bEnabled)
+{
+	if (uiIndex > ABSOLUTE_PLAYER_LIMIT)
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid player index: %u", uiIndex)
+
+	if (bEnabled)
+		m_Players.Set(uiIndex);
+	else
+		m_Players.Clear(uiIndex);
+}
+
+void CUserCmdRule::SetEnabledForAll(bool bEnabled)
+{
+	if (bEnabled)
+		m_Players.SetAll();
+	else
+		m_Players.ClearAll();
+}
+
+
+//-----------------------------------------------------------------------------
+// CUserCmdRuleManager.
+//-----------------------------------------------------------------------------
+UserCmdRulePtr CUserCmdRuleManager::AddButtonMask(int iButtons)
+{
+	UserCmdRulePtr pRule(new CUserCmdRule(USERCMD_RULE_BUTTON_MASK));
+	pRule->m_iButtons = iButtons;
+	m_vecRules.push_back(pRule);
+	return pRule;
+}
+
+UserCmdRulePtr CUserCmdRuleManager::AddClamp(UserCmdRuleField field, float fMin, float fMax)
+{
+	UserCmdRulePtr pRule(new CUserCmdRule(USERCMD_RULE_CLAMP));
+	pRule->m_Field = field;
+	pRule->SetRange(fMin, fMax);
+	m_vecRules.push_back(pRule);
+	return pRule;
+}
+
+void CUserCmdRuleManager::RemoveRule(UserCmdRulePtr pRule)
+{
+	m_vecRules.erase(
+		std::remove(m_vecRules.begin(), m_vecRules.end(), pRule),
+		m_vecRules.end());
+}
+
+void CUserCmdRuleManager::Clear()
+{
+	m_vecRules.clear();
+}
+
+int CUserCmdRuleManager::GetCount()
+{
+	return (int) m_vecRules.size();
+}
+
+void CUserCmdRuleManager::Apply(unsigned int uiIndex, CUserCmd* pCmd)
+{
+	for (std::vector<UserCmdRulePtr>::iterator it = m_vecRules.begin(); it != m_vecRules.end(); ++it)
+	{
+		CUserCmdRule* pRule = it->get();
+		if (pRule->m_Players.IsBitSet(uiIndex))
+			pRule->Apply(pCmd);
+	}
+}
@@ -0,0 +1,122 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2015 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+#ifndef _PLAYERS_USERCMD_H
+#define _PLAYERS_USERCMD_H
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#include <vector>
+#include "boost/shared_ptr.hpp"
+#include "const.h"
+#include "bitvec.h"
+
+class CUserCmd;
+
+
+//-----------------------------------------------------------------------------
+// Rule types.
+//-----------------------------------------------------------------------------
+enum UserCmdRuleType
+{
+	USERCMD_RULE_BUTTON_MASK,
+	USERCMD_RULE_CLAMP
+};
+
+
+//-----------------------------------------------------------------------------
+// Fields that can be clamped.
+//-----------------------------------------------------------------------------
+enum UserCmdRuleField
+{
+	USERCMD_RULE_PITCH,
+	USERCMD_RULE_YAW,
+	USERCMD_RULE_ROLL,
+	USERCMD_RULE_FORWARD_MOVE,
+	USERCMD_RULE_SIDE_MOVE,
+	USERCMD_RULE_UP_MOVE,
+	USERCMD_RULE_MOUSE_DX,
+	USERCMD_RULE_MOUSE_DY
+};
+
+
+//-----------------------------------------------------------------------------
+// A single rewriting rule. It is enabled for all players by default.
+//-----------------------------------------------------------------------------
+class CUserCmdRule
+{
+public:
+	CUserCmdRule(UserCmdRuleType type);
+
+	void Apply(CUserCmd* pCmd);
+
+	float GetMin();
+	void SetMin(float fMin);
+	float GetMax();
+	void SetMax(float fMax);
+	void SetRange(float fMin, float fMax);
+
+	bool IsEnabled(unsigned int uiIndex);
+	void SetEnabled(unsigned int uiIndex, bool bEnabled);
+	void SetEnabledForAll(bool bEnabled);
+
+public:
+	UserCmdRuleType		m_Type;
+	int					m_iButtons;
+	UserCmdRuleField	m_Field;
+	float				m_fMin;
+	float				m_fMax;
+	CBitVec<ABSOLUTE_PLAYER_LIMIT + 1>	m_Players;
+};
+
+typedef boost::shared_ptr<CUserCmdRule> UserCmdRulePtr;
+
+
+//-----------------------------------------------------------------------------
+// Applies CUserCmd rewriting rules in PrePlayerRunCommand without calling
+// into Python.
+//-----------------------------------------------------------------------------
+class CUserCmdRuleManager
+{
+public:
+	UserCmdRulePtr AddButtonMask(int iButtons);
+	UserCmdRulePtr AddClamp(UserCmdRuleField field, float fMin, float fMax);
+	void RemoveRule(UserCmdRulePtr pRule);
+	void Clear();
+	int GetCount();
+
+	void Apply(unsigned int uiIndex, CUserCmd* pCmd);
+
+private:
+	std::vector<UserCmdRulePtr> m_vecRules;
+};
+
+extern CUserCmdRuleManager g_UserCmdRuleManager;
+
+
+#endif // _PLAYERS_USERCMD_H
@@ -24,53 +24,283 @@
 * Development Team grants this exception to all derivative works.
 */
 
+
 //-----------------------------------------------------------------------------
 // Includes.
 //-----------------------------------------------------------------------------
-#include "ivoiceserver.h"
-#include "export_main.h"
-#include "modules/memory/memory_utilities.h"
+// Source.Python
+#include "players_voice.h"
+#include "utilities/wrap_macros.h"
+
+// SDK
+#include "edict.h"
+
+// Boost.Python
+#include "boost/python/stl_iterator.hpp"
 
 
 //-----------------------------------------------------------------------------
-// Externals
+// External variables.
 //-----------------------------------------------------------------------------
-extern IVoiceServer* voiceserver;
+extern CGlobalVars* gpGlobals;
 
 
 //-----------------------------------------------------------------------------
-// Forward declarations.
+// Globals.
 //-----------------------------------------------------------------------------
-void export_voice_server(scope);
+CVoiceMatrix g_VoiceMatrix;
 
 
 //-----------------------------------------------------------------------------
-// Declare the _players._voice module.
+// CVoiceMatrix.
 //-----------------------------------------------------------------------------
-DECLARE_SP_SUBMODULE(_players, _voice)
+CVoiceMatrix::CVoiceMatrix()
+{
+	m_iMutedCount = 0;
+	m_bTeamOnly = false;
+	m_bAliveOnly = false;
+	m_flProximity = 0;
+}
+
+void CVoiceMatrix::Initialize(CFunction* pSetClientListening)
 {
-	export_voice_server(_voice);
+	if (!pSetClientListening->IsHookable())
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Function is not hookable.")
+
+	CHook* pHook = GetHookManager()->FindHook((void*) pSetClientListening->m_ulAddr);
+	if (!pHook)
+	{
+		pHook = GetHookManager()->HookFunction((void*) pSetClientListening->m_ulAddr, pSetClientListening->m_pCallingConvention);
+		if (!pHook)
+			BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Could not create a hook.")
+	}
+
+	// It won't be added twice if the module has been reloaded
+	pHook->AddCallback(HOOKTYPE_PRE, (HookHandlerFn*) (void*) &PreSetClientListening);
+}
+
+void CVoiceMatrix::CheckPlayerIndex(unsigned int uiPlayer)
+{
+	if (uiPlayer == WORLD_ENTITY_INDEX || uiPlayer > ABSOLUTE_PLAYER_LIMIT)
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid player index: %u.", uiPlayer)
+}
+
+void CVoiceMatrix::GetIndexes(object indexes, VoiceBits& output, bool bAllIfNone)
+{
+	output.ClearAll();
+	if (indexes.is_none())
+	{
+		if (!bAllIfNone)
+			return;
+
+		for (unsigned int i=1; i <= ABSOLUTE_PLAYER_LIMIT; i++)
+			output.Set(i);
+
+		return;
+	}
+
+	extract<unsigned int> index(indexes);
+	if (index.check())
+	{
+		CheckPlayerIndex(index());
+		output.Set(index());
+		return;
+	}
+
+	stl_input_iterator<unsigned int> it(indexes), end;
+	for (; it != end; ++it)
+	{
+		CheckPlayerIndex(*it);
+		output.Set(*it);
+	}
 }
 
 
 //-----------------------------------------------------------------------------
-// Exports IVoiceServer.
+// Mute rules.
 //-----------------------------------------------------------------------------
-void export_voice_server(scope _voice)
+void CVoiceMatrix::SetMuted(object senders, object receivers, bool bMuted)
+{
+	VoiceBits sender_bits, receiver_bits;
+	GetIndexes(senders, sender_bits, false);
+	GetIndexes(receivers, receiver_bits, true);
+
+	for (int iReceiver = receiver_bits.FindNextSetBit(0); iReceiver != -1; iReceiver = receiver_bits.FindNextSetBit(iReceiver + 1))
+	{
+		VoiceBits& muted = m_Muted[iReceiver];
+		for (int iSender = sender_bits.FindNextSetBit(0); iSender != -1; iSender = sender_bits.FindNextSetBit(iSender + 1))
+		{
+			if (muted.IsBitSet(iSender) == bMuted)
+				continue;
+
+			if (bMuted)
+			{
+				muted.Set(iSender);
+				m_iMutedCount++;
+			}
+			else
+			{
+				muted.Clear(iSender);
+				m_iMutedCount--;
+			}
+		}
+	}
+}
+
+void CVoiceMatrix::Mute(object senders, object receivers)
 {
-	class_<IVoiceServer, IVoiceServer*, boost::noncopyable> _VoiceServer("_VoiceServer", no_init);
+	SetMuted(senders, receivers, true);
+}
+
+void CVoiceMatrix::Unmute(object senders, object receivers)
+{
+	SetMuted(senders, receivers, false);
+}
+
+bool CVoiceMatrix::IsMuted(unsigned int uiSender, object receivers)
+{
+	CheckPlayerIndex(uiSender);
 
-	_VoiceServer.def("get_client_listening", &IVoiceServer::GetClientListening);
-	_VoiceServer.def("set_client_listening", &IVoiceServer::SetClientListening);
-	_VoiceServer.def("set_client_proximity", &IVoiceServer::SetClientProximity);
+	VoiceBits receiver_bits;
+	GetIndexes(receivers, receiver_bits, true);
 
-	_VoiceServer ADD_MEM_TOOLS(IVoiceServer);
+	for (int iReceiver = receiver_bits.FindNextSetBit(0); iReceiver != -1; iReceiver = receiver_bits.FindNextSetBit(iReceiver + 1))
+	{
+		if (!m_Muted[iReceiver].IsBitSet(uiSender))
+			return false;
+	}
 
-	_voice.attr("voice_server") = object(ptr(voiceserver));
+	return true;
+}
+
+list CVoiceMatrix::GetMutedSenders(unsigned int uiReceiver)
+{
+	CheckPlayerIndex(uiReceiver);
+
+	list senders;
+	VoiceBits& muted = m_Muted[uiReceiver];
+	for (int iSender = muted.FindNextSetBit(0); iSender != -1; iSender = muted.FindNextSetBit(iSender + 1))
+		senders.append(iSender);
+
+	return senders;
+}
 
-	BEGIN_CLASS_INFO(IVoiceServer)
-		FUNCTION_INFO(GetClientListening)
-		FUNCTION_INFO(SetClientListening)
-		FUNCTION_INFO(SetClientProximity)
-	END_CLASS_INFO()
-}
\ No newline at end of file
+void CVoiceMatrix::Clear()
+{
+	for (unsigned int i=0; i < PLAYER_STATE_SLOTS; i++)
+		m_Muted[i].ClearAll();
+
+	m_iMutedCount = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Mode rules.
+//-----------------------------------------------------------------------------
+bool CVoiceMatrix::GetTeamOnly()
+{
+	return m_bTeamOnly;
+}
+
+void CVoiceMatrix::SetTeamOnly(bool bTeamOnly)
+{
+	m_bTeamOnly = bTeamOnly;
+}
+
+bool CVoiceMatrix::GetAliveOnly()
+{
+	return m_bAliveOnly;
+}
+
+void CVoiceMatrix::SetAliveOnly(bool bAliveOnly)
+{
+	m_bAliveOnly = bAliveOnly;
+}
+
+float CVoiceMatrix::GetProximity()
+{
+	return m_flProximity;
+}
+
+void CVoiceMatrix::SetProximity(float flProximity)
+{
+	m_flProximity = flProximity < 0 ? 0 : flProximity;
+}
+
+bool CVoiceMatrix::HasRules()
+{
+	return m_iMutedCount > 0 || m_bTeamOnly || m_bAliveOnly || m_flProximity > 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Evaluates all rules for a single receiver and sender.
+//-----------------------------------------------------------------------------
+bool CVoiceMatrix::CanHear(unsigned int uiReceiver, unsigned int uiSender)
+{
+	if (uiReceiver == WORLD_ENTITY_INDEX || uiReceiver > (unsigned int) gpGlobals->maxClients
+		|| uiSender == WORLD_ENTITY_INDEX || uiSender > (unsigned int) gpGlobals->maxClients)
+		return true;
+
+	if (m_Muted[uiReceiver].IsBitSet(uiSender))
+		return false;
+
+	if (!m_bTeamOnly && !m_bAliveOnly && m_flProximity <= 0)
+		return true;
+
+	if (m_bTeamOnly && g_PlayerStateTable.GetTeam(uiReceiver) != g_PlayerStateTable.GetTeam(uiSender))
+		return false;
+
+	// The dead can still hear the living
+	if (m_bAliveOnly && !g_PlayerStateTable.IsAlive(uiSender) && g_PlayerStateTable.IsAlive(uiReceiver))
+		return false;
+
+	if (m_flProximity > 0)
+	{
+		Vector vecDelta = g_PlayerStateTable.GetOrigin(uiReceiver) - g_PlayerStateTable.GetOrigin(uiSender);
+		if (vecDelta.LengthSqr() > m_flProximity * m_flProximity)
+			return false;
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------
+// Client notifications.
+//-----------------------------------------------------------------------------
+void CVoiceMatrix::OnClientDisconnect(unsigned int uiIndex)
+{
+	if (uiIndex == WORLD_ENTITY_INDEX || uiIndex > ABSOLUTE_PLAYER_LIMIT)
+		return;
+
+	// Unmute the player, so the next player who gets this index won't be muted
+	for (unsigned int i=1; i < PLAYER_STATE_SLOTS; i++)
+	{
+		if (!m_Muted[i].IsBitSet(uiIndex))
+			continue;
+
+		m_Muted[i].Clear(uiIndex);
+		m_iMutedCount--;
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+// Hook handler.
+//-----------------------------------------------------------------------------
+bool CVoiceMatrix::PreSetClientListening(HookType_t eHookType, CHook* pHook)
+{
+	if (!g_VoiceMatrix.HasRules() || !pHook->GetArgument<bool>(3))
+		return false;
+
+	int iReceiver = pHook->GetArgument<int>(1);
+	int iSender = pHook->GetArgument<int>(2);
+	if (iReceiver <= 0 || iSender <= 0)
+		return false;
+
+	if (!g_VoiceMatrix.CanHear((unsigned int) iReceiver, (unsigned int) iSender))
+		pHook->SetArgument<bool>(3, false);
+
+	return false;
+}
@@ -0,0 +1,115 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2015 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+#ifndef _PLAYERS_VOICE_H
+#define _PLAYERS_VOICE_H
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+// DynamicHooks
+#include "hook.h"
+
+// Boost.Python
+#include "boost/python.hpp"
+using namespace boost::python;
+
+// SDK
+#include "bitvec.h"
+#include "const.h"
+
+// Source.Python
+#include "modules/memory/memory_function.h"
+#include "modules/players/players_state.h"
+
+
+//-----------------------------------------------------------------------------
+// Constants.
+//-----------------------------------------------------------------------------
+typedef CBitVec<PLAYER_STATE_SLOTS> VoiceBits;
+
+
+//-----------------------------------------------------------------------------
+// Native voice routing that is applied in a SetClientListening hook.
+//
+// Bit n of m_Muted[r] means that receiver r can't hear sender n. The mode
+// rules are evaluated from the player state snapshot of the current tick.
+//-----------------------------------------------------------------------------
+class CVoiceMatrix
+{
+public:
+	CVoiceMatrix();
+
+	void Initialize(CFunction* pSetClientListening);
+
+	// Mute rules. Senders and receivers can be an index or an iterable of
+	// indexes. If receivers is None, all player slots are used.
+	void Mute(object senders, object receivers);
+	void Unmute(object senders, object receivers);
+	bool IsMuted(unsigned int uiSender, object receivers);
+	list GetMutedSenders(unsigned int uiReceiver);
+
+	void Clear();
+
+	// Returns True if the receiver can hear the sender
+	bool CanHear(unsigned int uiReceiver, unsigned int uiSender);
+
+	// Mode rules
+	bool GetTeamOnly();
+	void SetTeamOnly(bool bTeamOnly);
+
+	bool GetAliveOnly();
+	void SetAliveOnly(bool bAliveOnly);
+
+	float GetProximity();
+	void SetProximity(float flProximity);
+
+	// Client notifications
+	void OnClientDisconnect(unsigned int uiIndex);
+
+	// Hook handler
+	static bool PreSetClientListening(HookType_t eHookType, CHook* pHook);
+
+private:
+	bool HasRules();
+	void SetMuted(object senders, object receivers, bool bMuted);
+	void GetIndexes(object indexes, VoiceBits& output, bool bAllIfNone);
+	void CheckPlayerIndex(unsigned int uiPlayer);
+
+private:
+	VoiceBits		m_Muted[PLAYER_STATE_SLOTS];
+	int				m_iMutedCount;
+
+	bool			m_bTeamOnly;
+	bool			m_bAliveOnly;
+	float			m_flProximity;
+};
+
+extern CVoiceMatrix g_VoiceMatrix;
+
+
+#endif // _PLAYERS_VOICE_H
@@ -0,0 +1,177 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2015 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#include "ivoiceserver.h"
+#include "export_main.h"
+#include "modules/memory/memory_utilities.h"
+#include "players_voice.h"
+
+
+//-----------------------------------------------------------------------------
+// Externals
+//-----------------------------------------------------------------------------
+extern IVoiceServer* voiceserver;
+
+
+//-----------------------------------------------------------------------------
+// Forward declarations.
+//-----------------------------------------------------------------------------
+void export_voice_server(scope);
+void export_voice_matrix(scope);
+
+
+//-----------------------------------------------------------------------------
+// Declare the _players._voice module.
+//-----------------------------------------------------------------------------
+DECLARE_SP_SUBMODULE(_players, _voice)
+{
+	export_voice_server(_voice);
+	export_voice_matrix(_voice);
+}
+
+
+//-----------------------------------------------------------------------------
+// Exports IVoiceServer.
+//-----------------------------------------------------------------------------
+void export_voice_server(scope _voice)
+{
+	class_<IVoiceServer, IVoiceServer*, boost::noncopyable> _VoiceServer("_VoiceServer", no_init);
+
+	_VoiceServer.def("get_client_listening", &IVoiceServer::GetClientListening);
+	_VoiceServer.def("set_client_listening", &IVoiceServer::SetClientListening);
+	_VoiceServer.def("set_client_proximity", &IVoiceServer::SetClientProximity);
+
+	_VoiceServer ADD_MEM_TOOLS(IVoiceServer);
+
+	_voice.attr("voice_server") = object(ptr(voiceserver));
+
+	BEGIN_CLASS_INFO(IVoiceServer)
+		FUNCTION_INFO(GetClientListening)
+		FUNCTION_INFO(SetClientListening)
+		FUNCTION_INFO(SetClientProximity)
+	END_CLASS_INFO()
+}
+
+//-----------------------------------------------------------------------------
+// Exports CVoiceMatrix.
+//-----------------------------------------------------------------------------
+void export_voice_matrix(scope _voice)
+{
+	class_<CVoiceMatrix, boost::noncopyable> VoiceMatrix("VoiceMatrix", no_init);
+
+	VoiceMatrix.def(
+		"initialize",
+		&CVoiceMatrix::Initialize,
+		"Hook the given SetClientListening function to apply the voice rules.\n\n"
+		":param Function function:\n"
+		"    The IVoiceServer::SetClientListening function.",
+		args("function"));
+
+	VoiceMatrix.def(
+		"mute",
+		&CVoiceMatrix::Mute,
+		"Mute the given senders for the given receivers.\n\n"
+		":param int/iterable senders:\n"
+		"    The index or indexes of the players to mute.\n"
+		":param int/iterable receivers:\n"
+		"    The index or indexes of the players that shouldn't hear the senders.\n"
+		"    If None, the senders are muted for all player slots.",
+		(arg("senders"), arg("receivers")=object()));
+
+	VoiceMatrix.def(
+		"unmute",
+		&CVoiceMatrix::Unmute,
+		"Unmute the given senders for the given receivers.\n\n"
+		":param int/iterable senders:\n"
+		"    The index or indexes of the players to unmute.\n"
+		":param int/iterable receivers:\n"
+		"    The index or indexes of the players that should hear the senders again.\n"
+		"    If None, the senders are unmuted for all player slots.",
+		(arg("senders"), arg("receivers")=object()));
+
+	VoiceMatrix.def(
+		"is_muted",
+		&CVoiceMatrix::IsMuted,
+		"Return whether the given sender is muted for all the given receivers.\n\n"
+		":param int sender:\n"
+		"    The index of the player to check.\n"
+		":param int/iterable receivers:\n"
+		"    The index or indexes of the receivers to check. If None, all\n"
+		"    player slots are checked.\n"
+		":rtype: bool",
+		(arg("sender"), arg("receivers")=object()));
+
+	VoiceMatrix.def(
+		"get_muted_senders",
+		&CVoiceMatrix::GetMutedSenders,
+		"Return the indexes of all senders the given receiver can't hear.\n\n"
+		":param int receiver:\n"
+		"    The index of the receiver.\n"
+		":rtype: list",
+		args("receiver"));
+
+	VoiceMatrix.def(
+		"can_hear",
+		&CVoiceMatrix::CanHear,
+		"Return whether the receiver can hear the sender with the current rules.\n\n"
+		":param int receiver:\n"
+		"    The index of the listening player.\n"
+		":param int sender:\n"
+		"    The index of the talking player.\n"
+		":rtype: bool",
+		args("receiver", "sender"));
+
+	VoiceMatrix.def(
+		"clear",
+		&CVoiceMatrix::Clear,
+		"Unmute all players. The mode rules are not changed.");
+
+	VoiceMatrix.add_property(
+		"team_only",
+		&CVoiceMatrix::GetTeamOnly,
+		&CVoiceMatrix::SetTeamOnly,
+		"If True, players only hear players of their own team.\n\n"
+		":rtype: bool");
+
+	VoiceMatrix.add_property(
+		"alive_only",
+		&CVoiceMatrix::GetAliveOnly,
+		&CVoiceMatrix::SetAliveOnly,
+		"If True, living players don't hear dead players.\n\n"
+		":rtype: bool");
+
+	VoiceMatrix.add_property(
+		"proximity",
+		&CVoiceMatrix::GetProximity,
+		&CVoiceMatrix::SetProximity,
+		"If greater than 0, players only hear players within this distance.\n\n"
+		":rtype: float");
+
+	_voice.attr("voice_matrix") = object(ptr(&g_VoiceMatrix));
+}
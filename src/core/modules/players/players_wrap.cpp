@@ -39,6 +39,8 @@
 #include "inetchannel.h"
 #include "players_wrap.h"
 #include "players_entity.h"
+#include "players_state.h"
+#include "players_usercmd.h"
 
 #include ENGINE_INCLUDE_PATH(players_wrap.h)
 
@@ -50,7 +52,9 @@ void export_playerinfo(scope);
 void export_player_generator(scope);
 void export_client(scope);
 void export_user_cmd(scope);
+void export_user_cmd_rules(scope);
 void export_player_wrapper(scope);
+void export_player_state_table(scope);
 
 
 //-----------------------------------------------------------------------------
@@ -62,7 +66,9 @@ DECLARE_SP_MODULE(_players)
 	export_player_generator(_players);
 	export_client(_players);
 	export_user_cmd(_players);
+	export_user_cmd_rules(_players);
 	export_player_wrapper(_players);
+	export_player_state_table(_players);
 }
 
 
@@ -197,7 +203,14 @@ void export_playerinfo(scope _players)
 //-----------------------------------------------------------------------------
 void export_player_generator(scope _players)
 {
-	class_<CPlayerGenerator>("PlayerGenerator")
+	class_<CPlayerGenerator>("PlayerGenerator",
+		init< optional<unsigned int, unsigned int> >(
+			(arg("is_mask")=0, arg("not_mask")=0),
+			"Iterate over all players matching the given filter masks.\n\n"
+			":param int is_mask: A player is yielded if it has all bits of this mask.\n"
+			":param int not_mask: A player is skipped if it has any bit of this mask."
+		)
+	)
 		.def("__iter__",
 			&CPlayerGenerator::iter,
 			"Returns the iterable object."
@@ -209,6 +222,21 @@ void export_player_generator(scope _players)
 			reference_existing_object_policy()
 		)
 	;
+
+	enum_<PlayerFilterMask>("PlayerFilterMask")
+		.value("HUMAN", PLAYER_FILTER_HUMAN)
+		.value("BOT", PLAYER_FILTER_BOT)
+		.value("ALIVE", PLAYER_FILTER_ALIVE)
+		.value("DEAD", PLAYER_FILTER_DEAD)
+	;
+
+	def("get_team_filter_mask",
+		&GetTeamFilterMask,
+		"Return the filter mask of the given team number.\n\n"
+		":param int team: The team number.\n"
+		":rtype: int",
+		args("team")
+	);
 }
 
 
@@ -351,6 +379,129 @@ void export_user_cmd(scope _players)
 	UserCmd ADD_MEM_TOOLS(CUserCmd);
 }
 
+
+//-----------------------------------------------------------------------------
+// Exports CUserCmdRule and CUserCmdRuleManager.
+//-----------------------------------------------------------------------------
+void export_user_cmd_rules(scope _players)
+{
+	enum_<UserCmdRuleField>("UserCmdRuleField")
+		.value("PITCH", USERCMD_RULE_PITCH)
+		.value("YAW", USERCMD_RULE_YAW)
+		.value("ROLL", USERCMD_RULE_ROLL)
+		.value("FORWARD_MOVE", USERCMD_RULE_FORWARD_MOVE)
+		.value("SIDE_MOVE", USERCMD_RULE_SIDE_MOVE)
+		.value("UP_MOVE", USERCMD_RULE_UP_MOVE)
+		.value("MOUSE_DX", USERCMD_RULE_MOUSE_DX)
+		.value("MOUSE_DY", USERCMD_RULE_MOUSE_DY)
+	;
+
+	class_<CUserCmdRule, UserCmdRulePtr, boost::noncopyable> UserCmdRule("UserCmdRule", no_init);
+
+	UserCmdRule.def(
+		"is_enabled",
+		&CUserCmdRule::IsEnabled,
+		"Return whether the rule is applied to the given player.\n\n"
+		":param int index: The player index.\n"
+		":rtype: bool",
+		args("index")
+	);
+
+	UserCmdRule.def(
+		"set_enabled",
+		&CUserCmdRule::SetEnabled,
+		"Set whether the rule is applied to the given player.\n\n"
+		":param int index: The player index.\n"
+		":param bool enabled: Whether the rule should be applied.",
+		args("index", "enabled")
+	);
+
+	UserCmdRule.def(
+		"set_enabled_for_all",
+		&CUserCmdRule::SetEnabledForAll,
+		"Set whether the rule is applied to all players.\n\n"
+		":param bool enabled: Whether the rule should be applied.",
+		args("enabled")
+	);
+
+	UserCmdRule.def_readwrite(
+		"buttons",
+		&CUserCmdRule::m_iButtons,
+		"Buttons that are removed by a button mask rule.\n\n"
+		":rtype: int"
+	);
+
+	UserCmdRule.add_property(
+		"min",
+		&CUserCmdRule::GetMin,
+		&CUserCmdRule::SetMin,
+		"Minimum value of a clamp rule.\n\n"
+		":rtype: float\n"
+		":raise ValueError: Raised if the value is not finite or greater than the maximum."
+	);
+
+	UserCmdRule.add_property(
+		"max",
+		&CUserCmdRule::GetMax,
+		&CUserCmdRule::SetMax,
+		"Maximum value of a clamp rule.\n\n"
+		":rtype: float\n"
+		":raise ValueError: Raised if the value is not finite or less than the minimum."
+	);
+
+	UserCmdRule.def_readonly(
+		"field",
+		&CUserCmdRule::m_Field,
+		"The field of a clamp rule.\n\n"
+		":rtype: UserCmdRuleField"
+	);
+
+	class_<CUserCmdRuleManager, boost::noncopyable> UserCmdRuleManager("UserCmdRuleManager", no_init);
+
+	UserCmdRuleManager.def(
+		"add_button_mask",
+		&CUserCmdRuleManager::AddButtonMask,
+		"Add a rule that removes the given buttons from every command.\n\n"
+		":param int buttons: The buttons to remove.\n"
+		":rtype: UserCmdRule",
+		args("buttons")
+	);
+
+	UserCmdRuleManager.def(
+		"add_clamp",
+		&CUserCmdRuleManager::AddClamp,
+		"Add a rule that clamps the given field of every command.\n\n"
+		":param UserCmdRuleField field: The field to clamp.\n"
+		":param float min: The minimum value.\n"
+		":param float max: The maximum value.\n"
+		":rtype: UserCmdRule\n"
+		":raise ValueError: Raised if a value is not finite or the minimum is greater than the maximum.",
+		args("field", "min", "max")
+	);
+
+	UserCmdRuleManager.def(
+		"remove_rule",
+		&CUserCmdRuleManager::RemoveRule,
+		"Remove the given rule.\n\n"
+		":param UserCmdRule rule: The rule to remove.",
+		args("rule")
+	);
+
+	UserCmdRuleManager.def(
+		"clear",
+		&CUserCmdRuleManager::Clear,
+		"Remove all rules."
+	);
+
+	UserCmdRuleManager.def(
+		"__len__",
+		&CUserCmdRuleManager::GetCount,
+		"Return the number of rules."
+	);
+
+	_players.attr("user_cmd_rule_manager") = object(ptr(&g_UserCmdRuleManager));
+}
+
 void export_player_wrapper(scope _players)
 {
 	class_<PlayerMixin, bases<CBaseEntityWrapper>, boost::noncopyable> _PlayerMixin("PlayerMixin", no_init);
@@ -587,6 +738,13 @@ void export_player_wrapper(scope _players)
 		"Get/set the player's view vector.\n\n"
 		":rtype: Vector");
 
+	_PlayerMixin.def(
+		"get_view_vector_into",
+		&PlayerMixin::GetViewVectorInto,
+		"Write the player's view vector into an existing vector.\n\n"
+		":param Vector output: The vector to write to.",
+		args("output"));
+
 	_PlayerMixin.add_property(
 		"view_angle",
 		&PlayerMixin::GetViewAngle,
@@ -756,3 +914,139 @@ void export_player_wrapper(scope _players)
 	ADD_SIZE(PlayerMixin)
 	STORE_CLASS(PlayerMixin, "PlayerMixin")
 }
+
+
+//-----------------------------------------------------------------------------
+// Exports CPlayerStateTable.
+//-----------------------------------------------------------------------------
+void export_player_state_table(scope _players)
+{
+	enum_<PlayerStateField>("PlayerStateField")
+		.value("CONNECTED", PLAYER_STATE_CONNECTED)
+		.value("ALIVE", PLAYER_STATE_ALIVE)
+		.value("BOT", PLAYER_STATE_BOT)
+		.value("TEAM", PLAYER_STATE_TEAM)
+		.value("USERID", PLAYER_STATE_USERID)
+		.value("FILTER_MASK", PLAYER_STATE_FILTER_MASK)
+		.value("ORIGIN", PLAYER_STATE_ORIGIN)
+		.value("EYE_ANGLES", PLAYER_STATE_EYE_ANGLES)
+	;
+
+	class_<CPlayerStateTable, boost::noncopyable> PlayerStateTable("PlayerStateTable", no_init);
+
+	PlayerStateTable.add_property(
+		"tick",
+		&CPlayerStateTable::GetTick,
+		"Return the tick of the current snapshot or -1 if there is none.\n\n"
+		":rtype: int"
+	);
+
+	PlayerStateTable.def(
+		"update",
+		&CPlayerStateTable::ForceUpdate,
+		"Take a new snapshot, even if one has already been taken this tick."
+	);
+
+	PlayerStateTable.def(
+		"is_connected",
+		&CPlayerStateTable::IsConnected,
+		"Return whether the player is connected.\n\n"
+		":param int index: The player index.\n"
+		":rtype: bool",
+		args("index")
+	);
+
+	PlayerStateTable.def(
+		"is_alive",
+		&CPlayerStateTable::IsAlive,
+		"Return whether the player is alive.\n\n"
+		":param int index: The player index.\n"
+		":rtype: bool",
+		args("index")
+	);
+
+	PlayerStateTable.def(
+		"is_bot",
+		&CPlayerStateTable::IsBot,
+		"Return whether the player is a bot.\n\n"
+		":param int index: The player index.\n"
+		":rtype: bool",
+		args("index")
+	);
+
+	PlayerStateTable.def(
+		"get_team",
+		&CPlayerStateTable::GetTeam,
+		"Return the team of the player.\n\n"
+		":param int index: The player index.\n"
+		":rtype: int",
+		args("index")
+	);
+
+	PlayerStateTable.def(
+		"get_userid",
+		&CPlayerStateTable::GetUserID,
+		"Return the userid of the player.\n\n"
+		":param int index: The player index.\n"
+		":rtype: int",
+		args("index")
+	);
+
+	PlayerStateTable.def(
+		"get_filter_mask",
+		&CPlayerStateTable::GetFilterMask,
+		"Return the :class:`PlayerFilterMask` bits of the player.\n\n"
+		":param int index: The player index.\n"
+		":rtype: int",
+		args("index")
+	);
+
+	PlayerStateTable.def(
+		"get_steamid",
+		&CPlayerStateTable::GetSteamID,
+		"Return the SteamID of the player.\n\n"
+		":param int index: The player index.\n"
+		":rtype: str",
+		args("index")
+	);
+
+	PlayerStateTable.def(
+		"get_language",
+		&CPlayerStateTable::GetLanguage,
+		"Return the language of the player or an empty string if it's unknown.\n\n"
+		":param int index: The player index.\n"
+		":rtype: str",
+		args("index")
+	);
+
+	PlayerStateTable.def(
+		"get_origin",
+		&CPlayerStateTable::GetOrigin,
+		"Return the origin of the player.\n\n"
+		":param int index: The player index.\n"
+		":rtype: Vector",
+		args("index")
+	);
+
+	PlayerStateTable.def(
+		"get_eye_angles",
+		&CPlayerStateTable::GetEyeAngles,
+		"Return the eye angles of the player.\n\n"
+		":param int index: The player index.\n"
+		":rtype: QAngle",
+		args("index")
+	);
+
+	PlayerStateTable.def(
+		"get_view",
+		&CPlayerStateTable::GetView,
+		"Return a read-only memoryview of the given field, indexed by player index.\n\n"
+		"The view shares the memory of the table, which is updated once per "
+		"tick. Copy it if the values need to be kept.\n\n"
+		":param PlayerStateField field: The field to view.\n"
+		":rtype: memoryview",
+		args("field")
+	);
+
+	_players.attr("player_state_table") = object(ptr(&g_PlayerStateTable));
+}
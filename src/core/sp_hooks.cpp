@@ -42,12 +42,16 @@ using namespace boost::python;
 #include "utilities/call_python.h"
 #include "modules/entities/entities_entity.h"
 #include "modules/listeners/listeners_manager.h"
+#include "modules/memory/memory_tools.h"
+#include "modules/players/players_usercmd.h"
+#include "mathlib/vector.h"
 
 
 //---------------------------------------------------------------------------------
 // GLOBAL VARIABLES
 //---------------------------------------------------------------------------------
 std::vector<IEntityHook*> g_EntityHooks;
+CRunCommandFieldListenerManager g_RunCommandFieldListenerManager;
 
 
 //---------------------------------------------------------------------------------
@@ -129,6 +133,120 @@ bool PlayerHook::Test(CBaseEntity* pEntity)
 }
 
 
+//---------------------------------------------------------------------------------
+// CRunCommandFieldListenerManager
+//---------------------------------------------------------------------------------
+CRunCommandFieldListenerManager::CRunCommandFieldListenerManager()
+{
+	m_uiFields = 0;
+}
+
+void CRunCommandFieldListenerManager::RegisterListener(object oCallable, unsigned int uiFields)
+{
+	int iIndex = FindListener(oCallable);
+	if (iIndex != -1)
+	{
+		m_vecListeners[iIndex].m_uiFields = uiFields;
+	}
+	else
+	{
+		RunCommandFieldListener_t listener;
+		listener.m_oCallable = oCallable;
+		listener.m_uiFields = uiFields;
+		m_vecListeners.AddToTail(listener);
+	}
+
+	UpdateFields();
+}
+
+void CRunCommandFieldListenerManager::UnregisterListener(object oCallable)
+{
+	int iIndex = FindListener(oCallable);
+	if (iIndex == -1)
+		return;
+
+	m_vecListeners.Remove(iIndex);
+	UpdateFields();
+}
+
+int CRunCommandFieldListenerManager::GetCount()
+{
+	return m_vecListeners.Count();
+}
+
+int CRunCommandFieldListenerManager::FindListener(object oCallable)
+{
+	for (int i = 0; i < m_vecListeners.Count(); i++)
+	{
+		if (is_same_func(oCallable, m_vecListeners[i].m_oCallable))
+			return i;
+	}
+
+	return -1;
+}
+
+void CRunCommandFieldListenerManager::UpdateFields()
+{
+	m_uiFields = 0;
+	for (int i = 0; i < m_vecListeners.Count(); i++)
+		m_uiFields |= m_vecListeners[i].m_uiFields;
+}
+
+void CRunCommandFieldListenerManager::Notify(unsigned int uiIndex, CUserCmd* pCmd)
+{
+	// Convert every requested field only once
+	object values[USERCMD_FIELD_COUNT];
+
+	BEGIN_BOOST_PY()
+		if (m_uiFields & USERCMD_FIELD_COMMAND_NUMBER)
+			values[0] = object(pCmd->command_number);
+		if (m_uiFields & USERCMD_FIELD_TICK_COUNT)
+			values[1] = object(pCmd->tick_count);
+		if (m_uiFields & USERCMD_FIELD_VIEW_ANGLES)
+			values[2] = object(pCmd->viewangles);
+		if (m_uiFields & USERCMD_FIELD_FORWARD_MOVE)
+			values[3] = object(pCmd->forwardmove);
+		if (m_uiFields & USERCMD_FIELD_SIDE_MOVE)
+			values[4] = object(pCmd->sidemove);
+		if (m_uiFields & USERCMD_FIELD_UP_MOVE)
+			values[5] = object(pCmd->upmove);
+		if (m_uiFields & USERCMD_FIELD_BUTTONS)
+			values[6] = object(pCmd->buttons);
+		if (m_uiFields & USERCMD_FIELD_IMPULSE)
+			values[7] = object(pCmd->impulse);
+		if (m_uiFields & USERCMD_FIELD_WEAPON_SELECT)
+			values[8] = object(pCmd->weaponselect);
+		if (m_uiFields & USERCMD_FIELD_WEAPON_SUBTYPE)
+			values[9] = object(pCmd->weaponsubtype);
+		if (m_uiFields & USERCMD_FIELD_RANDOM_SEED)
+			values[10] = object(pCmd->random_seed);
+		if (m_uiFields & USERCMD_FIELD_MOUSE_DX)
+			values[11] = object(pCmd->mousedx);
+		if (m_uiFields & USERCMD_FIELD_MOUSE_DY)
+			values[12] = object(pCmd->mousedy);
+	END_BOOST_PY_NORET()
+
+	for (int i = 0; i < m_vecListeners.Count(); i++)
+	{
+		BEGIN_BOOST_PY()
+			// Pass the index, followed by the requested fields in the order
+			// of their bits
+			list args;
+			args.append(uiIndex);
+
+			unsigned int uiFields = m_vecListeners[i].m_uiFields;
+			for (int iField = 0; iField < USERCMD_FIELD_COUNT; iField++)
+			{
+				if (uiFields & (1 << iField))
+					args.append(values[iField]);
+			}
+
+			m_vecListeners[i].m_oCallable(*tuple(args));
+		END_BOOST_PY_NORET()
+	}
+}
+
+
 //---------------------------------------------------------------------------------
 // FUNCTIONS
 //---------------------------------------------------------------------------------
@@ -172,43 +290,63 @@ bool PrePlayerRunCommand(HookType_t hook_type, CHook* pHook)
 	GET_LISTENER_MANAGER(OnPlayerRunCommand, run_command_manager);
 	GET_LISTENER_MANAGER(OnButtonStateChanged, button_state_manager);
 
-	if (!run_command_manager->GetCount() && !button_state_manager->GetCount())
+	if (!run_command_manager->GetCount() && !button_state_manager->GetCount()
+		&& !g_RunCommandFieldListenerManager.GetCount() && !g_UserCmdRuleManager.GetCount())
 		return false;
 
-	static object Player = import("players.entity").attr("Player");
-
 	CBaseEntity* pEntity = pHook->GetArgument<CBaseEntity*>(0);
 	unsigned int index;
 	if (!IndexFromBaseEntity(pEntity, index))
 		return false;
-	
-	// https://github.com/Source-Python-Dev-Team/Source.Python/issues/149
+
+	CUserCmd* pCmd = pHook->GetArgument<CUserCmd*>(1);
+
+	// Apply the native rules first, so listeners see the rewritten command
+	if (g_UserCmdRuleManager.GetCount())
+		g_UserCmdRuleManager.Apply(index, pCmd);
+
+	if (!run_command_manager->GetCount() && !button_state_manager->GetCount()
+		&& !g_RunCommandFieldListenerManager.GetCount())
+		return false;
+
+	// Player objects are only created if a listener needs one
+	static object Player = import("players.entity").attr("Player");
+	object player;
+
+	if (run_command_manager->GetCount())
+	{
+		player = Player(index);
+
+		// https://github.com/Source-Python-Dev-Team/Source.Python/issues/149
 #if defined(ENGINE_BRANCH_TF2)
-	CUserCmd cmd = *pHook->GetArgument<CUserCmd*>(1);
-	CUserCmd* pCmd = &cmd;
+		CUserCmd cmd = *pCmd;
+		CALL_LISTENERS(OnPlayerRunCommand, player, ptr(&cmd));
+		memcpy(pCmd, &cmd, sizeof(CUserCmd));
 #else
-	CUserCmd* pCmd = pHook->GetArgument<CUserCmd*>(1);
+		CALL_LISTENERS(OnPlayerRunCommand, player, ptr(pCmd));
 #endif
+	}
 
-	object player = Player(index);
-	CALL_LISTENERS(OnPlayerRunCommand, player, ptr(pCmd));
+	// Field listeners only receive copies of the fields, so they don't need
+	// the TF2 workaround
+	if (g_RunCommandFieldListenerManager.GetCount())
+		g_RunCommandFieldListenerManager.Notify(index, pCmd);
 
 	if (button_state_manager->GetCount())
 	{
+		// m_nButtons still holds the buttons of the previous command
 		CBaseEntityWrapper* pWrapper = (CBaseEntityWrapper*) pEntity;
 		static int offset = pWrapper->FindDatamapPropertyOffset("m_nButtons");
 
 		int buttons = pWrapper->GetDatamapPropertyByOffset<int>(offset);
 		if (buttons != pCmd->buttons)
 		{
+			if (player.is_none())
+				player = Player(index);
+
 			CALL_LISTENERS(OnButtonStateChanged, player, buttons, pCmd->buttons);
 		}
 	}
-	
-#if defined(ENGINE_BRANCH_TF2)
-	CUserCmd* pRealCmd = pHook->GetArgument<CUserCmd*>(1);
-	memcpy(pRealCmd, pCmd, sizeof(CUserCmd));
-#endif
 
 	return false;
 }
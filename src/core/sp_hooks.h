@@ -35,6 +35,13 @@
 // DynamicHooks
 #include "hook.h"
 
+// Boost.Python
+#include "boost/python.hpp"
+using namespace boost::python;
+
+// SDK
+#include "tier1/utlvector.h"
+
 
 //---------------------------------------------------------------------------------
 // IEntityHook
@@ -90,6 +97,64 @@ void InitHooks();
 void InitHooks(CBaseEntity* pEntity);
 
 
+//---------------------------------------------------------------------------------
+// CUserCmd fields that can be requested by run command field listeners.
+//---------------------------------------------------------------------------------
+enum UserCmdField
+{
+	USERCMD_FIELD_COMMAND_NUMBER	= (1 << 0),
+	USERCMD_FIELD_TICK_COUNT		= (1 << 1),
+	USERCMD_FIELD_VIEW_ANGLES		= (1 << 2),
+	USERCMD_FIELD_FORWARD_MOVE		= (1 << 3),
+	USERCMD_FIELD_SIDE_MOVE			= (1 << 4),
+	USERCMD_FIELD_UP_MOVE			= (1 << 5),
+	USERCMD_FIELD_BUTTONS			= (1 << 6),
+	USERCMD_FIELD_IMPULSE			= (1 << 7),
+	USERCMD_FIELD_WEAPON_SELECT		= (1 << 8),
+	USERCMD_FIELD_WEAPON_SUBTYPE	= (1 << 9),
+	USERCMD_FIELD_RANDOM_SEED		= (1 << 10),
+	USERCMD_FIELD_MOUSE_DX			= (1 << 11),
+	USERCMD_FIELD_MOUSE_DY			= (1 << 12)
+};
+
+#define USERCMD_FIELD_COUNT 13
+
+
+//---------------------------------------------------------------------------------
+// Run command listeners that receive the player index and only the requested
+// CUserCmd fields.
+//---------------------------------------------------------------------------------
+class CUserCmd;
+
+struct RunCommandFieldListener_t
+{
+	object			m_oCallable;
+	unsigned int	m_uiFields;
+};
+
+class CRunCommandFieldListenerManager
+{
+public:
+	CRunCommandFieldListenerManager();
+
+	void RegisterListener(object oCallable, unsigned int uiFields);
+	void UnregisterListener(object oCallable);
+	int GetCount();
+
+	void Notify(unsigned int uiIndex, CUserCmd* pCmd);
+
+private:
+	int FindListener(object oCallable);
+	void UpdateFields();
+
+private:
+	CUtlVector<RunCommandFieldListener_t>	m_vecListeners;
+	unsigned int							m_uiFields;
+};
+
+extern CRunCommandFieldListenerManager g_RunCommandFieldListenerManager;
+
+
 //---------------------------------------------------------------------------------
 // HOOKS
 //---------------------------------------------------------------------------------
@@ -60,6 +60,14 @@
 #include "utilities/conversions.h"
 #include "modules/entities/entities_entity.h"
 #include "modules/core/core.h"
+#include "modules/commands/commands_limiter.h"
+#include "modules/players/players_state.h"
+#include "modules/messages/messages.h"
+#include "modules/engines/engines_visibility.h"
+#include "modules/entities/entities_transmit.h"
+#include "modules/entities/entities_spatial.h"
+#include "modules/effects/effects_queue.h"
+#include "modules/players/players_voice.h"
 
 #ifdef _WIN32
 	#include "Windows.h"
@@ -91,6 +99,7 @@ IEngineSound*			enginesound			= NULL;
 CGlobalVars*			gpGlobals			= NULL;
 IFileSystem*			filesystem			= NULL;
 IServerGameDLL*			servergamedll		= NULL;
+IServerGameEnts*		servergameents		= NULL;
 IServerTools*			servertools			= NULL;
 IPhysics*				physics				= NULL;
 IPhysicsCollision*		physcollision		= NULL;
@@ -151,6 +160,7 @@ InterfaceHelper_t gGameInterfaces[] = {
 	{INTERFACEVERSION_PLAYERINFOMANAGER, (void **)&playerinfomanager},
 	{INTERFACEVERSION_PLAYERBOTMANAGER, (void **)&botmanager},
 	{INTERFACEVERSION_SERVERGAMEDLL, (void **)&servergamedll},
+	{INTERFACEVERSION_SERVERGAMEENTS, (void **)&servergameents},
 	{VSERVERTOOLS_INTERFACE_VERSION, (void **)&servertools},
 	{NULL, NULL}
 };
@@ -310,6 +320,9 @@ bool CSourcePython::Load(	CreateInterfaceFn interfaceFactory, CreateInterfaceFn
 		Msg(MSG_PREFIX "Could retrieve global variables.\n");
 		return false;
 	}
+
+	DevMsg(1, MSG_PREFIX "Building player lookup table...\n");
+	g_PlayerLookupTable.Rebuild();
 	
 	DevMsg(1, MSG_PREFIX "Initializing mathlib...\n");
 	MathLib_Init( 2.2f, 2.2f, 0.0f, 2.0f );
@@ -453,6 +466,11 @@ void CSourcePython::LevelInit( char const *pMapName )
 //-----------------------------------------------------------------------------
 void CSourcePython::ServerActivate( edict_t *pEdictList, int edictCount, int clientMax )
 {
+#ifndef USE_PROTOBUF
+	// All user messages have been registered at this point
+	g_UserMessageTable.Rebuild();
+#endif
+
 	list edicts;
 	for(int i=0; i < edictCount; i++)
 		edicts.append(pEdictList[i]);
@@ -465,7 +483,15 @@ void CSourcePython::ServerActivate( edict_t *pEdictList, int edictCount, int cli
 //-----------------------------------------------------------------------------
 void CSourcePython::GameFrame( bool simulating )
 {
+	// Keep the memory shared by the player state views current, even if
+	// nothing reads from the table during this tick
+	g_PlayerStateTable.Update();
+	g_VisibilityMatrix.OnTick();
+
 	CALL_LISTENERS(OnTick);
+
+	// Send the temp entities queued during this frame
+	g_TempEntityQueue.Flush();
 }
 
 //-----------------------------------------------------------------------------
@@ -474,6 +500,12 @@ void CSourcePython::GameFrame( bool simulating )
 void CSourcePython::LevelShutdown( void ) // !!!!this can get called multiple times per map change
 {
 	CALL_LISTENERS(OnLevelShutdown);
+
+	// The tick count starts over with the next map
+	g_PlayerStateTable.Invalidate();
+	g_VisibilityMatrix.Invalidate();
+	g_EntitySpatialIndex.Clear();
+	g_TempEntityQueue.Clear();
 }
 
 //-----------------------------------------------------------------------------
@@ -498,6 +530,12 @@ void CSourcePython::ClientDisconnect( edict_t *pEntity )
 		return;
 
 	CALL_LISTENERS(OnClientDisconnect, iEntityIndex);
+
+	g_CommandRateLimiter.ResetClient(iEntityIndex);
+	g_PlayerLookupTable.Remove(iEntityIndex);
+	g_PlayerStateTable.ClearSlot(iEntityIndex);
+	g_TransmitManager.OnClientDisconnect(iEntityIndex);
+	g_VoiceMatrix.OnClientDisconnect(iEntityIndex);
 }
 
 //-----------------------------------------------------------------------------
@@ -505,6 +543,13 @@ void CSourcePython::ClientDisconnect( edict_t *pEntity )
 //-----------------------------------------------------------------------------
 void CSourcePython::ClientPutInServer( edict_t *pEntity, char const *playername )
 {
+	unsigned int iEntityIndex;
+	if (IndexFromEdict(pEntity, iEntityIndex))
+	{
+		g_PlayerLookupTable.Update(iEntityIndex);
+		g_PlayerStateTable.UpdateLanguage(iEntityIndex);
+	}
+
 	CALL_LISTENERS(OnClientPutInServer, ptr(pEntity), playername);
 }
 
@@ -525,6 +570,10 @@ void CSourcePython::ClientSettingsChanged( edict_t *pEdict )
 	if (!IndexFromEdict(pEdict, iEntityIndex))
 		return;
 
+	// Bot unique IDs are based on their name
+	g_PlayerLookupTable.Update(iEntityIndex);
+	g_PlayerStateTable.UpdateLanguage(iEntityIndex);
+
 	CALL_LISTENERS(OnClientSettingsChanged, iEntityIndex);
 }
 
@@ -533,6 +582,12 @@ void CSourcePython::ClientSettingsChanged( edict_t *pEdict )
 //-----------------------------------------------------------------------------
 PLUGIN_RESULT CSourcePython::ClientConnect( bool *bAllowConnect, edict_t *pEntity, const char *pszName, const char *pszAddress, char *reject, int maxrejectlen )
 {
+	// The userid is assigned at this point and lookups don't scan the
+	// client slots, so make the client known as early as possible
+	unsigned int iEntityIndex;
+	if (IndexFromEdict(pEntity, iEntityIndex))
+		g_PlayerLookupTable.Update(iEntityIndex);
+
 	CPointer allowConnect = CPointer((unsigned long) bAllowConnect);
 	CPointer rejectMessage = CPointer((unsigned long) reject);
 	CALL_LISTENERS(OnClientConnect, allowConnect, ptr(pEntity), pszName, pszAddress, rejectMessage, maxrejectlen);
@@ -544,6 +599,8 @@ PLUGIN_RESULT CSourcePython::ClientConnect( bool *bAllowConnect, edict_t *pEntit
 //-----------------------------------------------------------------------------
 PLUGIN_RESULT CSourcePython::NetworkIDValidated( const char *pszUserName, const char *pszNetworkID )
 {
+	g_PlayerLookupTable.UpdateSteamID(pszNetworkID);
+
 	CALL_LISTENERS(OnNetworkidValidated, pszUserName, pszNetworkID);
 	return PLUGIN_CONTINUE;
 }
@@ -559,6 +616,9 @@ void CSourcePython::OnQueryCvarValueFinished( QueryCvarCookie_t iCookie, edict_t
 	if (!IndexFromEdict(pPlayerEntity, iEntityIndex))
 		return;
 
+	if (eStatus == eQueryCvarValueStatus_ValueIntact && V_strcmp(pCvarName, "cl_language") == 0)
+		g_PlayerStateTable.SetLanguage(iEntityIndex, pCvarValue);
+
 	CALL_LISTENERS(OnQueryCvarValueFinished, (int) iCookie, iEntityIndex, eStatus, pCvarName, pCvarValue);
 }
 
@@ -629,14 +689,15 @@ void CSourcePython::OnEntityCreated( CBaseEntity *pEntity )
 
 	InitHooks(pEntity);
 
+	unsigned int uiIndex;
+	bool bNetworked = IndexFromBaseEntity(pEntity, uiIndex);
+	if (bNetworked)
+		g_EntitySpatialIndex.OnEntityCreated(uiIndex);
+
 	CALL_LISTENERS(OnEntityCreated, ptr((CBaseEntityWrapper*) pEntity));
 
 	GET_LISTENER_MANAGER(OnNetworkedEntityCreated, on_networked_entity_created_manager);
-	if (!on_networked_entity_created_manager->GetCount())
-		return;
-
-	unsigned int uiIndex;
-	if (!IndexFromBaseEntity(pEntity, uiIndex))
+	if (!bNetworked || !on_networked_entity_created_manager->GetCount())
 		return;
 
 	static object Entity = import("entities").attr("entity").attr("Entity");
@@ -645,6 +706,8 @@ void CSourcePython::OnEntityCreated( CBaseEntity *pEntity )
 
 void CSourcePython::OnEntitySpawned( CBaseEntity *pEntity )
 {
+	g_TransmitManager.OnEntitySpawned(pEntity);
+
 	CALL_LISTENERS(OnEntitySpawned, ptr((CBaseEntityWrapper*) pEntity));
 
 	GET_LISTENER_MANAGER(OnNetworkedEntitySpawned, on_networked_entity_spawned_manager);
@@ -667,6 +730,9 @@ void CSourcePython::OnEntityDeleted( CBaseEntity *pEntity )
 	if (!IndexFromBaseEntity(pEntity, uiIndex))
 		return;
 
+	g_TransmitManager.OnEntityDeleted(uiIndex);
+	g_EntitySpatialIndex.OnEntityDeleted(uiIndex);
+
 	GET_LISTENER_MANAGER(OnNetworkedEntityDeleted, on_networked_entity_deleted_manager);
 	if (on_networked_entity_deleted_manager->GetCount())
 	{
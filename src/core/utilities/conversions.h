@@ -38,6 +38,10 @@
 #include "utilities/baseentity.h"
 #include "toolframework/itoolentity.h"
 #include "sp_util.h"
+#include "strtools.h"
+#include "const.h"
+#include "boost/unordered_map.hpp"
+#include "utilities/string_hash.h"
 
 BOOST_PYTHON_OPAQUE_SPECIALIZED_TYPE_ID(CBaseEntity)
 
@@ -289,6 +293,58 @@ CREATE_EXC_CONVERSION_FUNCTION(str, UniqueID, IPlayerInfo *, PlayerInfo);
 CREATE_EXC_CONVERSION_FUNCTION(str, UniqueID, unsigned int, Index);
 
 
+typedef boost::unordered_map<unsigned int, unsigned int> UseridIndexMap;
+typedef boost::unordered_map<std::string, unsigned int, StringHash, StringEqual> PlayerIDIndexMap;
+
+
+//-----------------------------------------------------------------------------
+// Cached identifiers of a single client slot.
+//-----------------------------------------------------------------------------
+struct PlayerLookupEntry_t
+{
+	bool			m_bActive;
+	unsigned int	m_uiUserID;
+	std::string		m_szSteamID;
+	std::string		m_szUniqueID;
+};
+
+
+//-----------------------------------------------------------------------------
+// Maps userids, SteamIDs and unique IDs to player indexes.
+//
+// The table is updated from the client callbacks of the server plugin.
+// Every hit is verified against the engine, so a stale entry is never
+// returned. A miss is reported as not found without scanning the client
+// slots. SteamIDs shared by multiple clients ("BOT", "STEAM_ID_PENDING" and
+// "STEAM_ID_LAN") are not mapped and are resolved by scanning the entries.
+//-----------------------------------------------------------------------------
+class CPlayerLookupTable
+{
+public:
+	CPlayerLookupTable();
+
+	void Update(unsigned int uiIndex);
+	void UpdateSteamID(const char* szSteamID);
+	void Remove(unsigned int uiIndex);
+	void Rebuild();
+
+	bool FindUserid(unsigned int uiUserID, unsigned int& output);
+	bool FindSteamID(const char* szSteamID, unsigned int& output);
+	bool FindUniqueID(const char* szUniqueID, unsigned int& output);
+
+private:
+	void Forget(unsigned int uiIndex);
+
+private:
+	PlayerLookupEntry_t	m_Entries[ABSOLUTE_PLAYER_LIMIT + 1];
+	UseridIndexMap		m_Userids;
+	PlayerIDIndexMap	m_SteamIDs;
+	PlayerIDIndexMap	m_UniqueIDs;
+};
+
+extern CPlayerLookupTable g_PlayerLookupTable;
+
+
 //-----------------------------------------------------------------------------
 // Helper functions
 //-----------------------------------------------------------------------------
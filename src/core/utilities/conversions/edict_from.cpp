@@ -57,18 +57,11 @@ bool EdictFromIndex( unsigned int iEntityIndex, edict_t*& output )
 //-----------------------------------------------------------------------------
 bool EdictFromUserid( unsigned int iUserID, edict_t*& output )
 {
-	for (int iCurrentIndex = 1; iCurrentIndex <= gpGlobals->maxClients; iCurrentIndex++)
-	{
-		edict_t* pEdict;
-		if (!EdictFromIndex(iCurrentIndex, pEdict))
-			continue;
-
-		if (engine->GetPlayerUserId(pEdict) == iUserID) {
-			output = pEdict;
-			return true;
-		}
-	}
-	return false;
+	unsigned int iEntityIndex;
+	if (!g_PlayerLookupTable.FindUserid(iUserID, iEntityIndex))
+		return false;
+
+	return EdictFromIndex(iEntityIndex, output);
 }
 
 
@@ -163,11 +163,7 @@ bool IndexFromIntHandle( unsigned int iEntityHandle, unsigned int& output )
 //-----------------------------------------------------------------------------
 bool IndexFromUserid( unsigned int iUserID, unsigned int& output )
 {
-	edict_t* pEdict;
-	if (!EdictFromUserid(iUserID, pEdict))
-		return false;
-
-	return IndexFromEdict(pEdict, output);
+	return g_PlayerLookupTable.FindUserid(iUserID, output);
 }
 
 
@@ -176,11 +172,10 @@ bool IndexFromUserid( unsigned int iUserID, unsigned int& output )
 //-----------------------------------------------------------------------------
 bool IndexFromPlayerInfo( IPlayerInfo *pPlayerInfo, unsigned int& output )
 {
-	edict_t* pEdict;
-	if (!EdictFromPlayerInfo(pPlayerInfo, pEdict))
+	if (!pPlayerInfo)
 		return false;
 
-	return IndexFromEdict(pEdict, output);
+	return IndexFromUserid(pPlayerInfo->GetUserID(), output);
 }
 
 
@@ -189,46 +184,14 @@ bool IndexFromPlayerInfo( IPlayerInfo *pPlayerInfo, unsigned int& output )
 //-----------------------------------------------------------------------------
 bool IndexFromSteamID( const char* szSteamID, unsigned int& output )
 {
-	IPlayerInfo* pInfo = NULL;
-
-	for (unsigned int i=1; i <= (unsigned int) gpGlobals->maxClients; ++i)
-	{
-		if (!PlayerInfoFromIndex(i, pInfo))
-			continue;
-
-		if (V_strcmp(pInfo->GetNetworkIDString(), szSteamID) == 0)
-		{
-			output = i;
-			return true;
-		}
-	}
-
-	return false;
+	return g_PlayerLookupTable.FindSteamID(szSteamID, output);
 }
 
 
 //-----------------------------------------------------------------------------
-// Returns an index instance from the given SteamID.
+// Returns an index instance from the given unique ID.
 //-----------------------------------------------------------------------------
 bool IndexFromUniqueID( const char* szUniqueID, unsigned int& output )
 {
-	for (unsigned int i=1; i <= (unsigned int) gpGlobals->maxClients; ++i)
-	{
-		IPlayerInfo* pInfo = NULL;
-		if (!PlayerInfoFromIndex(i, pInfo))
-			continue;
-		
-		char szTempUniqueID[UNIQUE_ID_SIZE] = "";
-		char* pTempUniqueID = (char*) szTempUniqueID;
-		if (!UniqueIDFromPlayerInfo2(pInfo, pTempUniqueID))
-			continue;
-
-		if (V_strcmp(szUniqueID, pTempUniqueID) == 0)
-		{
-			output = i;
-			return true;
-		}
-	}
-
-	return false;
-}
\ No newline at end of file
+	return g_PlayerLookupTable.FindUniqueID(szUniqueID, output);
+}
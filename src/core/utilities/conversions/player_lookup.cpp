@@ -0,0 +1,255 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2015 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#include "../conversions.h"
+
+
+//-----------------------------------------------------------------------------
+// Global player lookup table.
+//-----------------------------------------------------------------------------
+CPlayerLookupTable g_PlayerLookupTable;
+
+
+//-----------------------------------------------------------------------------
+// Removes the key from the map if it still refers to the given index.
+//-----------------------------------------------------------------------------
+template<class Map, class Key>
+static void EraseIfIndex(Map& map, const Key& key, unsigned int uiIndex)
+{
+	typename Map::iterator it = map.find(key);
+	if (it != map.end() && it->second == uiIndex)
+		map.erase(it);
+}
+
+
+//-----------------------------------------------------------------------------
+// Returns True if the SteamID can be used by multiple clients at once.
+//-----------------------------------------------------------------------------
+static bool IsSharedSteamID(const char* szSteamID)
+{
+	return V_strcmp(szSteamID, "BOT") == 0
+		|| V_strcmp(szSteamID, "STEAM_ID_PENDING") == 0
+		|| V_strcmp(szSteamID, "STEAM_ID_LAN") == 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// CPlayerLookupTable.
+//-----------------------------------------------------------------------------
+CPlayerLookupTable::CPlayerLookupTable()
+{
+	for (int i=0; i <= ABSOLUTE_PLAYER_LIMIT; ++i)
+	{
+		m_Entries[i].m_bActive = false;
+		m_Entries[i].m_uiUserID = INVALID_PLAYER_USERID;
+	}
+}
+
+void CPlayerLookupTable::Forget(unsigned int uiIndex)
+{
+	PlayerLookupEntry_t& entry = m_Entries[uiIndex];
+	if (!entry.m_bActive)
+		return;
+
+	EraseIfIndex(m_Userids, entry.m_uiUserID, uiIndex);
+	EraseIfIndex(m_SteamIDs, entry.m_szSteamID, uiIndex);
+	EraseIfIndex(m_UniqueIDs, entry.m_szUniqueID, uiIndex);
+
+	entry.m_bActive = false;
+	entry.m_uiUserID = INVALID_PLAYER_USERID;
+	entry.m_szSteamID.clear();
+	entry.m_szUniqueID.clear();
+}
+
+void CPlayerLookupTable::Update(unsigned int uiIndex)
+{
+	if (uiIndex == WORLD_ENTITY_INDEX || uiIndex > ABSOLUTE_PLAYER_LIMIT)
+		return;
+
+	Forget(uiIndex);
+
+	IPlayerInfo* pInfo = NULL;
+	if (!PlayerInfoFromIndex(uiIndex, pInfo))
+		return;
+
+	PlayerLookupEntry_t& entry = m_Entries[uiIndex];
+	entry.m_bActive = true;
+
+	int iUserID = pInfo->GetUserID();
+	if (iUserID != INVALID_PLAYER_USERID)
+	{
+		entry.m_uiUserID = iUserID;
+		m_Userids[entry.m_uiUserID] = uiIndex;
+	}
+
+	// Shared SteamIDs would map to the last client only, so they are
+	// resolved by FindSteamID through the entries instead
+	const char* szSteamID = pInfo->GetNetworkIDString();
+	if (szSteamID && *szSteamID)
+	{
+		entry.m_szSteamID = szSteamID;
+		if (!IsSharedSteamID(szSteamID))
+			m_SteamIDs[entry.m_szSteamID] = uiIndex;
+	}
+
+	char szUniqueID[UNIQUE_ID_SIZE] = "";
+	char* pUniqueID = (char*) szUniqueID;
+	if (UniqueIDFromPlayerInfo2(pInfo, pUniqueID))
+	{
+		entry.m_szUniqueID = szUniqueID;
+		m_UniqueIDs[entry.m_szUniqueID] = uiIndex;
+	}
+}
+
+void CPlayerLookupTable::UpdateSteamID(const char* szSteamID)
+{
+	if (!szSteamID || !*szSteamID)
+		return;
+
+	// The engine doesn't tell us which client has been validated, so only
+	// refresh the known clients whose SteamID has changed.
+	IPlayerInfo* pInfo = NULL;
+	for (unsigned int i=1; i <= (unsigned int) gpGlobals->maxClients; ++i)
+	{
+		PlayerLookupEntry_t& entry = m_Entries[i];
+		if (!entry.m_bActive || entry.m_szSteamID == szSteamID)
+			continue;
+
+		if (PlayerInfoFromIndex(i, pInfo) && V_strcmp(pInfo->GetNetworkIDString(), szSteamID) == 0)
+		{
+			Update(i);
+
+			// Multiple clients might share the same SteamID
+			if (!IsSharedSteamID(szSteamID))
+				return;
+		}
+	}
+}
+
+void CPlayerLookupTable::Remove(unsigned int uiIndex)
+{
+	if (uiIndex > ABSOLUTE_PLAYER_LIMIT)
+		return;
+
+	Forget(uiIndex);
+}
+
+void CPlayerLookupTable::Rebuild()
+{
+	for (int i=0; i <= ABSOLUTE_PLAYER_LIMIT; ++i)
+		Forget(i);
+
+	m_Userids.clear();
+	m_SteamIDs.clear();
+	m_UniqueIDs.clear();
+
+	for (unsigned int i=1; i <= (unsigned int) gpGlobals->maxClients; ++i)
+		Update(i);
+}
+
+bool CPlayerLookupTable::FindUserid(unsigned int uiUserID, unsigned int& output)
+{
+	edict_t* pEdict;
+	UseridIndexMap::iterator it = m_Userids.find(uiUserID);
+	if (it != m_Userids.end())
+	{
+		unsigned int uiIndex = it->second;
+		if (EdictFromIndex(uiIndex, pEdict) && engine->GetPlayerUserId(pEdict) == uiUserID)
+		{
+			output = uiIndex;
+			return true;
+		}
+
+		Update(uiIndex);
+	}
+
+	return false;
+}
+
+bool CPlayerLookupTable::FindSteamID(const char* szSteamID, unsigned int& output)
+{
+	IPlayerInfo* pInfo = NULL;
+	if (IsSharedSteamID(szSteamID))
+	{
+		for (unsigned int i=1; i <= (unsigned int) gpGlobals->maxClients; ++i)
+		{
+			if (!m_Entries[i].m_bActive || m_Entries[i].m_szSteamID != szSteamID)
+				continue;
+
+			if (PlayerInfoFromIndex(i, pInfo) && V_strcmp(pInfo->GetNetworkIDString(), szSteamID) == 0)
+			{
+				output = i;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	PlayerIDIndexMap::iterator it = m_SteamIDs.find(szSteamID, StringHash(), StringEqual());
+	if (it != m_SteamIDs.end())
+	{
+		unsigned int uiIndex = it->second;
+		if (PlayerInfoFromIndex(uiIndex, pInfo) && V_strcmp(pInfo->GetNetworkIDString(), szSteamID) == 0)
+		{
+			output = uiIndex;
+			return true;
+		}
+
+		Update(uiIndex);
+	}
+
+	return false;
+}
+
+bool CPlayerLookupTable::FindUniqueID(const char* szUniqueID, unsigned int& output)
+{
+	edict_t* pEdict;
+	PlayerIDIndexMap::iterator it = m_UniqueIDs.find(szUniqueID, StringHash(), StringEqual());
+	if (it != m_UniqueIDs.end())
+	{
+		// The unique ID only changes through the client callbacks, so it's
+		// enough to verify that the slot is still used by the same client
+		unsigned int uiIndex = it->second;
+		PlayerLookupEntry_t& entry = m_Entries[uiIndex];
+		if (entry.m_bActive
+			&& EdictFromIndex(uiIndex, pEdict)
+			&& engine->GetPlayerUserId(pEdict) == entry.m_uiUserID
+			&& V_strcmp(entry.m_szUniqueID.c_str(), szUniqueID) == 0)
+		{
+			output = uiIndex;
+			return true;
+		}
+
+		Update(uiIndex);
+	}
+
+	return false;
+}
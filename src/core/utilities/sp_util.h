@@ -29,6 +29,7 @@
 //-----------------------------------------------------------------------------
 // Includes
 //-----------------------------------------------------------------------------
+#include <vector>
 #include "utilities/wrap_macros.h"
 #include "boost/python.hpp"
 
@@ -133,6 +134,24 @@ void IndexSetter(T *pSelf, U pValue)
 }
 
 
+//-----------------------------------------------------------------------------
+// Returns the given values as an array.array of the given type code.
+//-----------------------------------------------------------------------------
+template<class T>
+object MakeArray(const char* szTypeCode, const std::vector<T>& values)
+{
+	static object ArrayType = import("array").attr("array");
+	object result = ArrayType(szTypeCode);
+	if (!values.empty())
+	{
+		result.attr("frombytes")(object(handle<>(PyBytes_FromStringAndSize(
+			(const char*) &values[0], values.size() * sizeof(T)))));
+	}
+
+	return result;
+}
+
+
 //-----------------------------------------------------------------------------
 // Dummy deleter function for shared_ptr that we are not owning.
 //-----------------------------------------------------------------------------
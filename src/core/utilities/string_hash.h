@@ -0,0 +1,97 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2015 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+#ifndef _STRING_HASH_H
+#define _STRING_HASH_H
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#include <string>
+#include <string.h>
+#include <ctype.h>
+#include "strtools.h"
+#include "boost/functional/hash.hpp"
+
+
+//-----------------------------------------------------------------------------
+// Hashing of std::string keys. Both functors also accept plain C strings, so
+// maps using them can be searched without creating a std::string.
+//-----------------------------------------------------------------------------
+struct StringHash
+{
+	std::size_t operator()(const char* szValue) const
+	{ return boost::hash_range(szValue, szValue + strlen(szValue)); }
+
+	std::size_t operator()(const std::string& value) const
+	{ return boost::hash_range(value.begin(), value.end()); }
+};
+
+struct StringEqual
+{
+	bool operator()(const char* szValue, const std::string& other) const
+	{ return strcmp(szValue, other.c_str()) == 0; }
+
+	bool operator()(const std::string& value, const char* szOther) const
+	{ return strcmp(value.c_str(), szOther) == 0; }
+
+	bool operator()(const std::string& value, const std::string& other) const
+	{ return value == other; }
+};
+
+
+//-----------------------------------------------------------------------------
+// Case insensitive variant of StringHash and StringEqual.
+//-----------------------------------------------------------------------------
+struct StringHashNoCase
+{
+	std::size_t operator()(const char* szValue) const
+	{
+		std::size_t seed = 0;
+		for (; *szValue; ++szValue)
+			boost::hash_combine(seed, tolower((unsigned char) *szValue));
+
+		return seed;
+	}
+
+	std::size_t operator()(const std::string& value) const
+	{ return (*this)(value.c_str()); }
+};
+
+struct StringEqualNoCase
+{
+	bool operator()(const char* szValue, const std::string& other) const
+	{ return V_stricmp(szValue, other.c_str()) == 0; }
+
+	bool operator()(const std::string& value, const char* szOther) const
+	{ return V_stricmp(value.c_str(), szOther) == 0; }
+
+	bool operator()(const std::string& value, const std::string& other) const
+	{ return V_stricmp(value.c_str(), other.c_str()) == 0; }
+};
+
+
+#endif // _STRING_HASH_H